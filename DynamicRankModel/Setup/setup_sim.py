@@ -26,7 +26,7 @@ flatten = lambda l: [item for sublist in l for item in sublist]
 base_path = os.path.abspath(os.path.dirname(__file__))
 
 # Header of input files (these are all parameters that C++ simulation code uses)
-full_input_list = ['Base','Net_in','TMax','NetDiscount','StratDiscount','NetLearningSpeed','StratLearningSpeed','NetSymmetric','StratSymmetric','NetTremble','StratTremble','CopyProb','CopyError','ExploreProb','InnovNoise','CoupleEffect','Game','OutFolder','Key']
+full_input_list = ['Base','Net_in','TMax','NetDiscount','StratDiscount','NetLearningSpeed','StratLearningSpeed','NetSymmetric','StratSymmetric','NetTremble','StratTremble','CopyProb','CopyError','ExploreProb','InnovNoise','CoupleEffect','Game','OutFolder','Key','RankModel','Substrate','Streams']
 
 def build_prev_inputs(full_inputpath):
     
@@ -69,7 +69,7 @@ def build_prev_inputs(full_inputpath):
     
     return all_inputs
 
-def setup_simulation(base_in, payoffs,pop_list_in = [20],net_discount_list_in = [0.01],strat_discount_list_in = [0.01],init_cond_hawk_p1_list_in = [50], init_cond_hawk_p2_list_in = [50], net_learningspeed_list_in = [1], strat_learningspeed_list_in = [1], net_tremble_list_in = [0.01], strat_tremble_list_in = [0.01],net_sym_list_in = [0], strat_sym_list_in = [0], total_weight=2,tmax_in = 1000000, copy_prob_list_in = [0.001], copy_error_list_in = [0.5], explore_prob_list_in = [0.5],innov_noise_list_in = [0.01], couple_effect="None",bonus_vec_list_in = [[0,0]], run_now = 0, num_seeds = 1, ruggednessk = 7):
+def setup_simulation(base_in, payoffs,pop_list_in = [20],net_discount_list_in = [0.01],strat_discount_list_in = [0.01],init_cond_hawk_p1_list_in = [50], init_cond_hawk_p2_list_in = [50], net_learningspeed_list_in = [1], strat_learningspeed_list_in = [1], net_tremble_list_in = [0.01], strat_tremble_list_in = [0.01],net_sym_list_in = [0], strat_sym_list_in = [0], total_weight=2,tmax_in = 1000000, copy_prob_list_in = [0.001], copy_error_list_in = [0.5], explore_prob_list_in = [0.5],innov_noise_list_in = [0.01], couple_effect="None",bonus_vec_list_in = [[0,0]], run_now = 0, num_seeds = 1, ruggednessk = 7, common_streams = 0):
     """ 
     THE FOLLOWING SETS ALL INPUT PARAMETERS FOR MODEL
     
@@ -95,6 +95,16 @@ def setup_simulation(base_in, payoffs,pop_list_in = [20],net_discount_list_in =
     # Game Type (Hawk Dove)
     # FIXED IN CCDN, THIS IS JUST FOR FILE NAMING
     game = "HDInnov"
+    
+    # Rank model the simulation binary runs these inputs with ("Static" or "Dynamic")
+    rank_model = "Dynamic"
+    
+    # Partners each agent can visit ("Complete", or a substrate graph such as "Ring:2", "Lattice", "ER:10", "SmallWorld:5:0.1", see the README)
+    substrate = "Complete"
+
+    # Random stream group: with common_streams every key made by this call shares one group, so for
+    # each seed they draw the same random numbers and their outputs can be compared seed by seed
+    streams = ''.join(random.SystemRandom().choice(string.ascii_uppercase + string.digits) for _ in range(8))
 
     # FOLDER WHERE INPUT FILES ARE STORED
     input_folder = game + "_Input/"
@@ -201,11 +211,11 @@ def setup_simulation(base_in, payoffs,pop_list_in = [20],net_discount_list_in =
         #initnet_path = os.path.abspath(os.path.join(initnet_folder,"Network_" + key + ".csv"))
 
         
-        input_params = [base_in,pop_in,tmax_in,net_discount_in,strat_discount_in,net_learningspeed_in,strat_learningspeed_in,net_sym_in,strat_sym_in,net_tremble_in,strat_tremble_in,copy_prob_in,copy_error_in, explore_prob_in, innov_noise_in, couple_effect, game,data_description,key]
+        input_params = [base_in,pop_in,tmax_in,net_discount_in,strat_discount_in,net_learningspeed_in,strat_learningspeed_in,net_sym_in,strat_sym_in,net_tremble_in,strat_tremble_in,copy_prob_in,copy_error_in, explore_prob_in, innov_noise_in, couple_effect, game,data_description,key,rank_model,substrate,streams if common_streams else key]
         
         rest_df = flatten(payoffs_in.values) + bonus_vec_in + flatten(init_strategy_fill_in)
 
-        full_row = np.array(input_params[:-1] + rest_df)
+        full_row = np.array(input_params[:-4] + input_params[-3:] + rest_df)
         
         #if not (all_inputs == full_row).all(1).any():
             
@@ -0,0 +1,709 @@
+#define NK_LEN 1048576
+
+/* The Agent class Implementation (Agent).cpp) */
+#include "Network.h" // user-defined header in the same directory
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <bitset>
+#include <math.h>
+#include <climits>
+#include <numeric>
+#include <algorithm>
+#include <vector>
+#include <tr1/functional>
+
+// Constructor
+// default values shall only be specified in the declaration,
+// cannot be repeated in definition
+Agent::Agent(Population &population, int agent_id, double fill_value, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob){
+    this->population = &population;
+    this->agent_id = agent_id;
+    this->network_learning_speed = network_learning_speed;
+    this->strategy_discount = strategy_discount;
+    this->network_discount = network_discount;
+    this->strategy_tremble = strategy_tremble;
+    this->network_tremble = network_tremble;
+    this->strategy_sym = strategy_sym;
+    this->network_sym = network_sym;
+    this->score_copy_prob = score_copy_prob;
+    this->copy_error = copy_error;
+    this->explore_prob = explore_prob;
+    network_scale_pending = 1;
+    
+    if(network_learning_speed == 0){
+        this->network_discount = 0;
+    }
+    if(strategy_learning_speed == 0){
+        this->strategy_discount = 0;
+    }
+        
+    for(int i = 0; i<population.num_roles; i++)
+    {
+        weight_t *new_strats = population.newStrats(agent_id, i);
+        for(int j = 0; j<population.num_strats; j++)
+        {
+            new_strats[j] = fill_value;
+        }
+    }
+    population.cur_score.at(agent_id) = 0;
+    population.new_score.at(agent_id) = 0;
+}
+
+Agent::Agent(Population &population, int agent_id, const std::vector<double> &fill_values, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob){
+    this->population = &population;
+    this->agent_id = agent_id;
+    this->strategy_learning_speed = strategy_learning_speed;
+    this->network_learning_speed = network_learning_speed;
+    this->strategy_discount = strategy_discount;
+    this->network_discount = network_discount;
+    this->strategy_tremble = strategy_tremble;
+    this->network_tremble = network_tremble;
+    this->strategy_sym = strategy_sym;
+    this->network_sym = network_sym;
+    this->score_copy_prob = score_copy_prob;
+    this->copy_error = copy_error;
+    this->explore_prob = explore_prob;
+    network_scale_pending = 1;
+    
+    if(this->network_learning_speed == 0){
+        this->network_discount = 0;
+    }
+    if(this->strategy_learning_speed == 0){
+        this->strategy_discount = 0;
+    }
+    
+    int num_strats_i = population.num_roles;
+    int num_strats_j = population.num_strats;
+    int index;
+    
+    for(int i = 0; i<num_strats_i; i++){
+        weight_t *new_strats = population.newStrats(agent_id, i);
+        for(int j = 0; j<num_strats_j; j++)
+        {
+            index = agent_id * num_strats_i * num_strats_j + i * num_strats_j + j;
+            new_strats[j] = fill_values.at(index);
+        }
+    }
+}
+
+std::vector<double> Agent::getStrats(int strat_num){
+    const weight_t *cur_strats = population->curStrats(agent_id, strat_num);
+    double scale = population->cur_strat_scale[agent_id * population->num_roles + strat_num];
+    
+    std::vector<double> strats(cur_strats, cur_strats + population->num_strats);
+    for(size_t i = 0; i < strats.size(); i++){
+        strats[i] = strats[i] * scale;
+    }
+    return strats;
+}
+
+void Agent::setStrats(int strat_num, const std::vector<double> &strats){
+    std::copy(strats.begin(), strats.end(), population->newStrats(agent_id, strat_num));
+    population->new_strat_scale[agent_id * population->num_roles + strat_num] = 1;
+}
+
+#ifdef WEIGHT_FLOOR
+// Zero the weights below WEIGHT_FLOOR times the row total
+static void floorWeights(weight_t *weights, int count){
+    double floor = WEIGHT_FLOOR * std::accumulate(weights, weights + count, 0.0);
+    for(int i = 0; i < count; i++){
+        if(weights[i] < floor){
+            weights[i] = 0;
+        }
+    }
+}
+#endif
+
+#ifdef SPARSE_NETWORK
+#ifdef WEIGHT_FLOOR
+// Return explicit weights below WEIGHT_FLOOR times the row total to the rest mass
+static void floorRow(SparseRow &row){
+    double floor = WEIGHT_FLOOR * (std::accumulate(row.weight, row.weight + row.count, 0.0) + row.rest);
+    int kept = 0;
+    for(int k = 0; k < row.count; k++){
+        if(row.weight[k] < floor){
+            row.rest = row.rest + row.weight[k];
+        }else{
+            row.partner[kept] = row.partner[k];
+            row.weight[kept] = row.weight[k];
+            kept++;
+        }
+    }
+    row.count = kept;
+}
+#endif
+
+// Add amount to partner's weight, promoting it out of the rest mass (others = pop - 1)
+static void addSparseWeight(SparseRow &row, int others, int partner, double amount){
+    int pos = (int) (std::lower_bound(row.partner, row.partner + row.count, partner) - row.partner);
+    if(pos < row.count && row.partner[pos] == partner){
+        row.weight[pos] = row.weight[pos] + amount;
+        return;
+    }
+    
+    // Row full: the smallest explicit weight goes back to the rest mass
+    if(row.count == SPARSE_NETWORK){
+        int evict = (int) (std::min_element(row.weight, row.weight + row.count) - row.weight);
+        row.rest = row.rest + row.weight[evict];
+        std::copy(row.partner + evict + 1, row.partner + row.count, row.partner + evict);
+        std::copy(row.weight + evict + 1, row.weight + row.count, row.weight + evict);
+        row.count--;
+        if(evict < pos){
+            pos--;
+        }
+    }
+    
+    // Partner takes its even share of the rest mass
+    double share = row.rest / (others - row.count);
+    row.rest = row.rest - share;
+    std::copy_backward(row.partner + pos, row.partner + row.count, row.partner + row.count + 1);
+    std::copy_backward(row.weight + pos, row.weight + row.count, row.weight + row.count + 1);
+    row.partner[pos] = partner;
+    row.weight[pos] = share + amount;
+    row.count++;
+}
+#endif
+
+void Agent::discountStrategy(int strat_num){
+    scaleStrategy(strat_num, 1-strategy_discount);
+}
+
+void Agent::scaleStrategy(int strat_num, double factor){
+    double &scale = population->new_strat_scale[agent_id * population->num_roles + strat_num];
+    scale = scale * factor;
+    
+    // Fold the scale back into the weights before they grow out of range
+    if(scale < DISCOUNT_RENORM_SCALE){
+        weight_t *new_strats = population->newStrats(agent_id, strat_num);
+        std::transform(new_strats, new_strats + population->num_strats, new_strats, std::bind2nd(std::multiplies<weight_t>(),scale));
+        #ifdef WEIGHT_FLOOR
+            floorWeights(new_strats, population->num_strats);
+        #endif
+        scale = 1;
+    }
+}
+
+void Agent::discountNeighbors(){
+    scaleNeighbors(1-network_discount);
+}
+
+void Agent::scaleNeighbors(double factor){
+    double &scale = population->new_weight_scale[agent_id];
+    scale = scale * factor;
+    
+    // Fold the scale back into the weights before they grow out of range
+    if(scale < DISCOUNT_RENORM_SCALE){
+#ifdef SPARSE_NETWORK
+        SparseRow &row = population->newRow(agent_id);
+        for(int k = 0; k < row.count; k++){
+            row.weight[k] = row.weight[k] * scale;
+        }
+        row.rest = row.rest * scale;
+        #ifdef WEIGHT_FLOOR
+            floorRow(row);
+        #endif
+#else
+        int row_len = population->rowLength(agent_id);
+        weight_t *new_friends = population->newFriends(agent_id);
+        
+        //Iterate over neighbors
+        for(int nid = 0; nid < row_len; nid++)
+        {
+            new_friends[nid] = new_friends[nid] * scale;
+        }
+        #ifdef WEIGHT_FLOOR
+            floorWeights(new_friends, row_len);
+        #endif
+#endif
+        network_scale_pending = network_scale_pending * scale;
+        scale = 1;
+        population->markRowDirty(agent_id);
+    }
+}
+
+void Agent::setFriends(std::vector<double> friends){
+    if(!population->holdsRow(agent_id)){
+        return; // Row held by another process
+    }
+#ifdef SPARSE_NETWORK
+    // Partners weighted above the row's mean stay explicit (the k largest), the rest is pooled
+    friends.at(agent_id) = 0;
+    double total = std::accumulate(friends.begin(), friends.end(), 0.0);
+    double mean = total / (population->pop - 1);
+    
+    std::vector<int> above;
+    for(int j = 0; j < population->pop; j++){
+        if(friends[j] > mean){
+            above.push_back(j);
+        }
+    }
+    if((int) above.size() > SPARSE_NETWORK){
+        std::nth_element(above.begin(), above.begin() + SPARSE_NETWORK, above.end(), [&friends](int a, int b){ return friends[a] > friends[b]; });
+        above.resize(SPARSE_NETWORK);
+    }
+    std::sort(above.begin(), above.end());
+    
+    SparseRow &row = population->newRow(agent_id);
+    row.count = (int) above.size();
+    row.rest = total;
+    for(int k = 0; k < row.count; k++){
+        row.partner[k] = above[k];
+        row.weight[k] = friends[above[k]];
+        row.rest = row.rest - friends[above[k]];
+    }
+#else
+    weight_t *new_friends = population->newFriends(agent_id);
+    for(int j = 0; j < population->rowLength(agent_id); j++){
+        new_friends[j] = friends.at(population->partnerAt(agent_id, j));
+    }
+#endif
+    population->new_weight_scale[agent_id] = 1;
+    population->markRowDirty(agent_id);
+}
+
+void Agent::setUniformFriends(double fill_value){
+    if(!population->holdsRow(agent_id)){
+        return;
+    }
+#ifdef SPARSE_NETWORK
+    SparseRow &row = population->newRow(agent_id);
+    row.count = 0;
+    row.rest = fill_value * (population->pop - 1);
+#else
+    weight_t *new_friends = population->newFriends(agent_id);
+    std::fill(new_friends, new_friends + population->rowLength(agent_id), fill_value);
+    if(population->substrate.complete()){
+        new_friends[agent_id] = 0;
+    }
+#endif
+    population->new_weight_scale[agent_id] = 1;
+    population->markRowDirty(agent_id);
+}
+
+std::vector<double> Agent::getFriends() const{
+#ifdef SPARSE_NETWORK
+    const SparseRow &row = population->curRow(agent_id);
+    double scale = population->cur_weight_scale[agent_id];
+    int implicit = population->pop - 1 - row.count;
+    
+    std::vector<double> friends(population->pop, implicit > 0 ? row.rest * scale / implicit : 0.0);
+    friends[agent_id] = 0;
+    for(int k = 0; k < row.count; k++){
+        friends[row.partner[k]] = row.weight[k] * scale;
+    }
+    return friends;
+#else
+    const weight_t *cur_friends = population->curFriends(agent_id);
+    double scale = population->cur_weight_scale[agent_id];
+    
+    std::vector<double> friends(population->pop, 0.0);
+    for(int j = 0; j < population->rowLength(agent_id); j++){
+        friends[population->partnerAt(agent_id, j)] = cur_friends[j] * scale;
+    }
+    return friends;
+#endif
+}
+
+
+void Agent::updateAgent(){
+    int strat_len = population->num_roles * population->num_strats;
+    
+    // Rows held by another process are committed there (only happens at construction)
+    if(population->holdsRow(agent_id)){
+#ifdef SPARSE_NETWORK
+        population->curRow(agent_id) = population->newRow(agent_id);
+#else
+        int row_len = population->rowLength(agent_id);
+        const weight_t *new_friends = population->newFriends(agent_id);
+        weight_t *cur_friends = population->curFriends(agent_id);
+        
+        // Discounting only moves the row scale, so new and cur differ just in the entries written this step
+        if(population->rowDirty(agent_id)){
+            std::copy(new_friends, new_friends + row_len, cur_friends);
+        }else{
+            const int *dirty = population->agentDirty(agent_id);
+            for(int k = 0; k < population->dirty_count[agent_id]; k++){
+                cur_friends[dirty[k]] = new_friends[dirty[k]];
+            }
+        }
+#endif
+        population->sampler->commit(agent_id, network_scale_pending);
+    }
+    std::copy(population->newStrats(agent_id, 0), population->newStrats(agent_id, 0) + strat_len, population->curStrats(agent_id, 0));
+    population->cur_weight_scale[agent_id] = population->new_weight_scale[agent_id];
+    for(int role = 0; role < population->num_roles; role++){
+        population->cur_strat_scale[agent_id * population->num_roles + role] = population->new_strat_scale[agent_id * population->num_roles + role];
+    }
+    
+    population->dirty_count[agent_id] = 0;
+    network_scale_pending = 1;
+    
+    // Dynamic ranks refresh their coupling transforms through Rank::commitScore
+    population->cur_score[agent_id] = population->new_score[agent_id];
+    perceived_cur_score = perceived_new_score;
+}
+
+template<class Gen>
+int Agent::chooseFriend(Gen &rng, const std::vector<int> &agent_seq, int seq_pos){
+    
+    // Draws only read the committed (cur) weights, so discounting new weights after the draw is equivalent
+    int friend_ind = chooseFixedFriend(rng, agent_seq, seq_pos);
+    
+    // Discount neighbors
+    discountNeighbors();
+    
+    return friend_ind;
+}
+
+template<class Gen>
+int Agent::chooseFixedFriend(Gen &rng, const std::vector<int> &agent_seq, int seq_pos){
+    
+    int friend_ind = -1; // Flag (goes >= 0 as the index) for when the neighbor is picked
+    #ifdef TREMBLE_SKIP
+        bool tremble = nextTremble(rng, 0, network_tremble);
+    #else
+        float rand_tremble = rng();
+        bool tremble = !(rand_tremble > network_tremble);
+    #endif
+    
+    int pop = population->pop;
+    
+    // If agent doesn't make an error
+    if(!tremble){
+        // Draw proportionally to current weights
+        friend_ind = population->sampler->sample(agent_id, rng());
+    }else if(population->substrate.complete()){ // If agent makes an error
+        // Choose random neighbor: uniform over agent_seq with own slot (seq_pos) skipped
+        int temp_friend_ind = (int) (rng() * (pop-1));
+        if(temp_friend_ind >= seq_pos){
+            temp_friend_ind++;
+        }
+        friend_ind = agent_seq[temp_friend_ind];
+        
+    }else{
+        // Uniform over the agent's substrate neighbors
+        friend_ind = population->partnerAt(agent_id, (int) (rng() * population->rowLength(agent_id)));
+    }
+    currentFriend = friend_ind;
+    
+    return friend_ind;
+}
+
+template int Agent::chooseFriend<UGenerator>(UGenerator &rng, const std::vector<int> &agent_seq, int seq_pos);
+template int Agent::chooseFriend<CounterStream>(CounterStream &rng, const std::vector<int> &agent_seq, int seq_pos);
+template int Agent::chooseFixedFriend<UGenerator>(UGenerator &rng, const std::vector<int> &agent_seq, int seq_pos);
+template int Agent::chooseFixedFriend<CounterStream>(CounterStream &rng, const std::vector<int> &agent_seq, int seq_pos);
+
+
+// Setters
+void Agent::updateInteractions(int inter_number){
+    int *my_interactions = population->agentInteractions(agent_id);
+    my_interactions[inter_number] = my_interactions[inter_number] + 1;
+}
+
+void Agent::setStrategyLearning(float strategy_learning_speed){
+    this->strategy_learning_speed = strategy_learning_speed;
+}
+void Agent::setNetworkLearning(float network_learning_speed){
+    this->network_learning_speed = network_learning_speed;
+}
+
+void Agent::setStrategyDiscount(float strategy_discount){
+    this->strategy_discount = strategy_discount;
+}
+void Agent::setNetworkDiscount(float network_discount){
+    this->network_discount = network_discount;
+}
+
+void Agent::setStrategyTremble(float strategy_tremble){
+    this->strategy_tremble = strategy_tremble;
+}
+void Agent::setNetworkTremble(float network_tremble){
+    this->network_tremble = network_tremble;
+}
+
+void Agent::setStrategySym(bool strategy_sym){
+    this->strategy_sym = strategy_sym;
+}
+void Agent::setNetworkSym(bool network_sym){
+    this->network_sym = network_sym;
+}
+
+void Agent::setScoreCopyProb(float score_copy_prob){
+    this->score_copy_prob = score_copy_prob;
+}
+
+void Agent::setCopyError(float copy_error){
+    this->copy_error = copy_error;
+}
+
+void Agent::setExploreProb(float explore_prob){
+    this->explore_prob = explore_prob;
+}
+
+template<class Rank>
+void Agent::addStrategyPayoff(int send_rec){
+    
+    addStrategyWeight(send_rec, currentStrategy, currentPayoff * strategy_learning_speed);
+    
+    // Static ranks only total the payoff, dynamic ranks score it
+    double *payoffs = Rank::payoffs(*population);
+    payoffs[agent_id] = payoffs[agent_id] + currentPayoff;
+    
+}
+
+template void Agent::addStrategyPayoff<StaticRank>(int send_rec);
+template void Agent::addStrategyPayoff<DynamicRank>(int send_rec);
+
+void Agent::addStrategyWeight(int send_rec, int strategy, double amount){
+    weight_t *new_strats = population->newStrats(agent_id, send_rec);
+    double scale = population->new_strat_scale[agent_id * population->num_roles + send_rec];
+    new_strats[strategy] = new_strats[strategy] + amount / scale;
+}
+
+void Agent::addNetworkPayoff(){
+    addNetworkWeight(currentFriend, currentPayoff * network_learning_speed);
+}
+
+void Agent::addNetworkWeight(int partner, double amount){
+    double scale = population->new_weight_scale[agent_id];
+#ifdef SPARSE_NETWORK
+    addSparseWeight(population->newRow(agent_id), population->pop - 1, partner, amount / scale);
+#else
+    weight_t *new_friends = population->newFriends(agent_id);
+    int column = population->columnOf(agent_id, partner);
+    new_friends[column] = new_friends[column] + amount / scale;
+    population->markDirty(agent_id, column);
+#endif
+}
+
+void Agent::setCurrentFriend(int friend_id){
+    currentFriend = friend_id;
+}
+
+// Strategy drawn from weights[0..k-1] by a uniform draw: the first strategy whose
+// cumulative weight exceeds draw times the total, found by counting the cumulative
+// weights at or below it (a compare and add per strategy, with no branch on the draw)
+static inline int categoricalDraw(const weight_t *weights, int k, double draw){
+    double total = 0.0;
+    for(int s = 0; s < k; s++){
+        total = total + weights[s];
+    }
+    double target = draw * total;
+    
+    double cumulative = 0.0;
+    int strategy = 0;
+    for(int s = 0; s < k - 1; s++){
+        cumulative = cumulative + weights[s];
+        strategy += cumulative <= target;
+    }
+    return strategy;
+}
+
+template<class Gen>
+int Agent::drawStrategy(Gen &rng, int send_rec){
+    
+    int strat_draw;
+    
+    double tremble_strat_draw;
+    double weight_strat_draw;
+    #ifdef TREMBLE_SKIP
+        bool tremble = nextTremble(rng, 1 + send_rec, strategy_tremble);
+    #else
+        double tremble_draw = rng();
+        bool tremble = tremble_draw < strategy_tremble;
+    #endif
+    
+    int num_strats = population->num_strats;
+    if(tremble){
+        tremble_strat_draw = rng();
+        if(num_strats == 2){
+            strat_draw = (int) (tremble_strat_draw + 0.5);
+        }else{
+            strat_draw = (int) (tremble_strat_draw * num_strats);
+        }
+    }else if(num_strats == 2){
+        const weight_t *cur_strats = population->curStrats(agent_id, send_rec);
+        double strat_sum_0 = cur_strats[0];
+        double strat_sum_1 = strat_sum_0 + cur_strats[1];
+        
+        weight_strat_draw = rng();
+        if(weight_strat_draw * strat_sum_1 < strat_sum_0){
+            strat_draw = 0;
+        }else{
+            strat_draw = 1;
+        }
+    }else{
+        weight_strat_draw = rng();
+        strat_draw = categoricalDraw(population->curStrats(agent_id, send_rec), num_strats, weight_strat_draw);
+    }
+    
+    return strat_draw;
+    
+}
+
+template<class Gen>
+void Agent::chooseStrategy(Gen &rng, int send_rec){
+    currentStrategy = drawStrategy(rng, send_rec);
+}
+
+template<class Gen>
+bool Agent::nextTremble(Gen &rng, int decision, double tremble){
+    int &gap = population->agentTrembleGaps(agent_id)[decision];
+    
+    // Count down to the next tremble (INT_MAX: never trembles)
+    if(gap > 0){
+        if(gap != INT_MAX){
+            gap--;
+        }
+        return false;
+    }
+    bool trembled = gap == 0; // -1: first decision, only draw the gap
+    
+    // Non-tremble decisions before the next tremble, P(k) = (1-p)^k p
+    if(tremble <= 0){
+        gap = INT_MAX;
+    }else if(tremble >= 1){
+        gap = 0;
+    }else{
+        double draw_gap = std::floor(std::log(1.0 - rng()) / std::log1p(-tremble));
+        gap = draw_gap < INT_MAX ? (int) draw_gap : INT_MAX;
+    }
+    
+    if(trembled){
+        return true;
+    }
+    return nextTremble(rng, decision, tremble);
+}
+
+template bool Agent::nextTremble<UGenerator>(UGenerator &rng, int decision, double tremble);
+template bool Agent::nextTremble<CounterStream>(CounterStream &rng, int decision, double tremble);
+
+template int Agent::drawStrategy<UGenerator>(UGenerator &rng, int send_rec);
+template int Agent::drawStrategy<CounterStream>(CounterStream &rng, int send_rec);
+template void Agent::chooseStrategy<UGenerator>(UGenerator &rng, int send_rec);
+template void Agent::chooseStrategy<CounterStream>(CounterStream &rng, int send_rec);
+
+void Agent::setCurrentPayoff(double currentPayoff){
+    this->currentPayoff = currentPayoff;
+}
+
+void Agent::recordInteraction(double visitPayoff, double hostPayoff){
+    past_p1_payoff = visitPayoff;
+    past_p2_payoff = hostPayoff;
+    last_visit = currentFriend;
+}
+template<class Gen>
+void Agent::setInitScore(Gen &rng){
+    population->cur_score[agent_id] = rng();
+    population->new_score[agent_id] = population->cur_score[agent_id];
+}
+
+template void Agent::setInitScore<UGenerator>(UGenerator &rng);
+template void Agent::setInitScore<CounterStream>(CounterStream &rng);
+
+//Getters
+std::vector<int> Agent::getInteractions(){
+    const int *my_interactions = population->agentInteractions(agent_id);
+    return std::vector<int>(my_interactions, my_interactions + population->num_interactions);
+}
+int Agent::getID(){
+    return agent_id;
+}
+float Agent::getStrategyLearning(){
+    return strategy_learning_speed;
+}
+float Agent::getNetworkLearning(){
+    return network_learning_speed;
+}
+
+float Agent::getStrategyDiscount(){
+    return strategy_discount;
+}
+float Agent::getNetworkDiscount(){
+    return network_discount;
+}
+
+float Agent::getStrategyTremble(){
+    return strategy_tremble;
+}
+float Agent::getNetworkTremble(){
+    return network_tremble;
+}
+
+bool Agent::getStrategySym(){
+    return strategy_sym;
+}
+bool Agent::getNetworkSym(){
+    return network_sym;
+}
+
+float Agent::getScoreCopyProb(){
+    return score_copy_prob;
+}
+
+float Agent::getCopyError(){
+    return copy_error;
+}
+
+float Agent::getExploreProb(){
+    return explore_prob;
+}
+
+int Agent::getCurrentStrategy(){
+    return currentStrategy;
+}
+
+void Agent::setCurrentStrategy(int strategy){
+    currentStrategy = strategy;
+}
+
+double Agent::getScore(){
+    return population->cur_score[agent_id];
+}
+
+double Agent::getScoreKey(){
+    return population->bonus_cache.score_key[agent_id];
+}
+
+int Agent::getLocationInt(){
+    return cur_location_int;
+}
+
+std::bitset<20> Agent::getLocationBin(){
+    return cur_location_bin;
+}
+
+double Agent::getPastVisitPayoff(){
+    return past_p1_payoff;
+}
+
+double Agent::getPastHostPayoff(){
+    return past_p2_payoff;
+}
+
+int Agent::getPastVisitPartner(){
+    return last_visit;
+}
+double Agent::getCurrentPayoff(){
+    return currentPayoff;
+}
+
+// Helpers
+
+int Agent::convertBin2Dec(std::bitset<20> bin){
+    return static_cast<int>(bin.to_ulong());
+}
+
+LearningParams::LearningParams(Agent &agent){
+    strategy_learning_speed = agent.getStrategyLearning();
+    network_learning_speed = agent.getNetworkLearning();
+    strategy_discount = agent.getStrategyDiscount();
+    network_discount = agent.getNetworkDiscount();
+    strategy_tremble = agent.getStrategyTremble();
+    network_tremble = agent.getNetworkTremble();
+    net_learn = network_learning_speed != 0;
+    net_sym = agent.getNetworkSym();
+    strat_sym = agent.getStrategySym();
+}
@@ -0,0 +1,188 @@
+/* The distributed run helpers (Distributed.cpp), built with -DUSE_MPI */
+#ifdef USE_MPI
+#include "Network.h" // user-defined header in the same directory
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+
+void startProcesses(int *argc, char ***argv){
+    // Only the main thread calls MPI (never from inside the run's parallel regions)
+    int provided;
+    MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided);
+    if(provided < MPI_THREAD_FUNNELED){
+        std::cerr << "Error: the MPI library does not support threads (MPI_THREAD_FUNNELED)\n";
+        _Exit(1);
+    }
+}
+
+void stopProcesses(){
+    MPI_Finalize();
+}
+
+int processRank(){
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+}
+
+int processCount(){
+    int ranks;
+    MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+    return ranks;
+}
+
+int firstRow(int pop, int rank){
+    return (int) ((long) pop * rank / processCount());
+}
+
+// Last process whose first row is at or before the agent
+int rowOwner(int pop, int agent){
+    return (int) (((long) (agent + 1) * processCount() - 1) / pop);
+}
+
+bool broadcastFlag(bool flag){
+    int value = flag;
+    MPI_Bcast(&value, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return value != 0;
+}
+
+// Every process's block of per-agent rows (row_bytes each) copied to all processes
+static void allgatherAgentRows(void *data, int row_bytes, int pop){
+    static std::vector<int> counts;
+    static std::vector<int> displs;
+    int ranks = processCount();
+    counts.resize(ranks);
+    displs.resize(ranks);
+    for(int r = 0; r < ranks; r++){
+        displs[r] = firstRow(pop, r);
+        counts[r] = firstRow(pop, r + 1) - displs[r];
+    }
+
+    MPI_Datatype row_type;
+    MPI_Type_contiguous(row_bytes, MPI_BYTE, &row_type);
+    MPI_Type_commit(&row_type);
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, data, counts.data(), displs.data(), row_type, MPI_COMM_WORLD);
+    MPI_Type_free(&row_type);
+}
+
+void syncCommitted(Population &population){
+    allgatherAgentRows(population.cur_strats.data(), (int) sizeof(weight_t) * population.num_roles * population.num_strats, population.pop);
+    allgatherAgentRows(population.cur_score.data(), (int) sizeof(double), population.pop);
+    allgatherAgentRows(population.bonus_cache.score_key.data(), (int) sizeof(double), population.pop);
+}
+
+// What a host needs of an interaction (sent as bytes: the processes share one machine
+// type)
+struct HostEvent{
+    int interaction;
+    int host;
+    int visit_strategy;
+    int host_strategy;
+    double host_payoff;
+};
+
+void exchangeHostEvents(Population &population, InteractionBatch &batch, const std::vector<int> &agent_seq){
+    // Reused across steps (a distributed run is the only simulation in the process)
+    static std::vector<HostEvent> outgoing;
+    static std::vector<HostEvent> incoming;
+    static std::vector<int> send_counts, send_displs, recv_counts, recv_displs, fill;
+
+    int ranks = processCount();
+    send_counts.assign(ranks, 0);
+    recv_counts.assign(ranks, 0);
+    send_displs.assign(ranks, 0);
+    recv_displs.assign(ranks, 0);
+
+    // Held visitors' interactions with hosts held elsewhere, grouped by destination
+    for(int i = 0; i < batch.size; i++){
+        if(population.holdsRow(agent_seq[i]) && !population.holdsRow(batch.host[i])){
+            send_counts[rowOwner(population.pop, batch.host[i])]++;
+        }
+    }
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    for(int r = 1; r < ranks; r++){
+        send_displs[r] = send_displs[r - 1] + send_counts[r - 1];
+        recv_displs[r] = recv_displs[r - 1] + recv_counts[r - 1];
+    }
+    outgoing.resize(send_displs[ranks - 1] + send_counts[ranks - 1]);
+    incoming.resize(recv_displs[ranks - 1] + recv_counts[ranks - 1]);
+
+    fill.assign(send_displs.begin(), send_displs.end());
+    for(int i = 0; i < batch.size; i++){
+        int host = batch.host[i];
+        if(population.holdsRow(agent_seq[i]) && !population.holdsRow(host)){
+            HostEvent &event = outgoing[fill[rowOwner(population.pop, host)]++];
+            event.interaction = i;
+            event.host = host;
+            event.visit_strategy = batch.visit_strategy[i];
+            event.host_strategy = batch.host_strategy[i];
+            event.host_payoff = batch.host_payoff[i];
+        }
+    }
+
+    MPI_Datatype event_type;
+    MPI_Type_contiguous((int) sizeof(HostEvent), MPI_BYTE, &event_type);
+    MPI_Type_commit(&event_type);
+    MPI_Alltoallv(outgoing.data(), send_counts.data(), send_displs.data(), event_type, incoming.data(), recv_counts.data(), recv_displs.data(), event_type, MPI_COMM_WORLD);
+    MPI_Type_free(&event_type);
+
+    // Other visitors' interactions point back at the visitor, so they index no held agent...
+    for(int i = 0; i < batch.size; i++){
+        if(!population.holdsRow(agent_seq[i])){
+            batch.host[i] = agent_seq[i];
+        }
+    }
+    // ...unless their host is held here
+    for(size_t k = 0; k < incoming.size(); k++){
+        const HostEvent &event = incoming[k];
+        batch.host[event.interaction] = event.host;
+        batch.visit_strategy[event.interaction] = event.visit_strategy;
+        batch.host_strategy[event.interaction] = event.host_strategy;
+        batch.host_payoff[event.interaction] = event.host_payoff;
+    }
+}
+
+template<class T>
+static void gatherValues(std::vector<T> &values, bool to_all, MPI_Datatype type){
+    static std::vector<int> counts;
+    static std::vector<int> displs;
+    int ranks = processCount();
+    counts.resize(ranks);
+    displs.resize(ranks);
+
+    int count = (int) values.size();
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    displs[0] = 0;
+    for(int r = 1; r < ranks; r++){
+        displs[r] = displs[r - 1] + counts[r - 1];
+    }
+
+    std::vector<T> local(values);
+    if(to_all){
+        values.resize(displs[ranks - 1] + counts[ranks - 1]);
+        MPI_Allgatherv(local.data(), count, type, values.data(), counts.data(), displs.data(), type, MPI_COMM_WORLD);
+    }else{
+        if(processRank() == 0){
+            values.resize(displs[ranks - 1] + counts[ranks - 1]);
+        }
+        MPI_Gatherv(local.data(), count, type, values.data(), counts.data(), displs.data(), type, 0, MPI_COMM_WORLD);
+    }
+}
+
+void gatherRows(std::vector<double> &values, bool to_all){
+    gatherValues(values, to_all, MPI_DOUBLE);
+}
+
+void gatherRows(std::vector<int> &values, bool to_all){
+    gatherValues(values, to_all, MPI_INT);
+}
+
+void sumToRoot(double *values, int count){
+    if(processRank() == 0){
+        MPI_Reduce(MPI_IN_PLACE, values, count, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    }else{
+        MPI_Reduce(values, nullptr, count, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    }
+}
+#endif
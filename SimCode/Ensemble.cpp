@@ -0,0 +1,447 @@
+/* The lockstep ensemble engine (Ensemble.cpp), built with -DENSEMBLE=S */
+#ifdef ENSEMBLE
+#include "Network.h" // user-defined header in the same directory
+#include <iostream>
+#include <numeric>
+#include <algorithm>
+#include <vector>
+
+#define LANES ENSEMBLE
+
+bool ensembleSupports(Network &net){
+    Population &population = net.getPopulation();
+    // Same partner picks as the scan (and fixed) samplers of a single run
+    return population.substrate.complete() && population.pop < SAMPLER_TREE_MIN_POP && population.num_roles == 2 && population.num_strats == 2;
+}
+
+// Learning state of LANES replicas of one population: Population's arrays (complete
+// rows, two roles of two strategies) with a trailing replica index
+struct EnsembleState{
+    int pop;
+
+    std::vector<weight_t> cur_weights; // pop x pop x LANES
+    std::vector<weight_t> new_weights;
+    std::vector<double> cur_weight_scale; // pop x LANES
+    std::vector<double> new_weight_scale;
+    std::vector<weight_t> cur_strats; // pop x 2 x 2 x LANES
+    std::vector<weight_t> new_strats;
+    std::vector<double> cur_strat_scale; // pop x 2 x LANES
+    std::vector<double> new_strat_scale;
+    std::vector<double> cur_score; // pop x LANES
+    std::vector<double> new_score;
+    std::vector<double> total_payoff;
+    std::vector<int> interactions; // pop x 4 x LANES
+    BonusCache bonus_cache;
+
+    // Each replica's shuffled order and every agent's place in it, LANES x pop
+    std::vector<int> agent_seq;
+    std::vector<int> seq_pos;
+
+    void init(int pop){
+        this->pop = pop;
+        cur_weights.assign((size_t) pop * pop * LANES, 0.0);
+        new_weights.assign((size_t) pop * pop * LANES, 0.0);
+        cur_weight_scale.assign(pop * LANES, 1.0);
+        new_weight_scale.assign(pop * LANES, 1.0);
+        cur_strats.assign(pop * 4 * LANES, 0.0);
+        new_strats.assign(pop * 4 * LANES, 0.0);
+        cur_strat_scale.assign(pop * 2 * LANES, 1.0);
+        new_strat_scale.assign(pop * 2 * LANES, 1.0);
+        cur_score.assign(pop * LANES, 0.0);
+        new_score.assign(pop * LANES, 0.0);
+        total_payoff.assign(pop * LANES, 0.0);
+        interactions.assign(pop * 4 * LANES, 0);
+        bonus_cache.init(pop * LANES);
+        agent_seq.assign(pop * LANES, 0);
+        seq_pos.assign(pop * LANES, 0);
+    }
+
+    template<class T>
+    static void toLane(const std::vector<T> &from, std::vector<T> &to, int r){
+        for(size_t i = 0; i < from.size(); i++){
+            to[i * LANES + r] = from[i];
+        }
+    }
+
+    template<class T>
+    static void fromLane(const std::vector<T> &from, std::vector<T> &to, int r){
+        for(size_t i = 0; i < to.size(); i++){
+            to[i] = from[i * LANES + r];
+        }
+    }
+
+    // Replica r from a member's population
+    void load(Population &population, int r){
+        toLane(population.cur_weights, cur_weights, r);
+        toLane(population.new_weights, new_weights, r);
+        toLane(population.cur_weight_scale, cur_weight_scale, r);
+        toLane(population.new_weight_scale, new_weight_scale, r);
+        toLane(population.cur_strats, cur_strats, r);
+        toLane(population.new_strats, new_strats, r);
+        toLane(population.cur_strat_scale, cur_strat_scale, r);
+        toLane(population.new_strat_scale, new_strat_scale, r);
+        toLane(population.cur_score, cur_score, r);
+        toLane(population.new_score, new_score, r);
+        toLane(population.total_payoff, total_payoff, r);
+        toLane(population.interactions, interactions, r);
+    }
+
+    // Replica r's uncommitted state into a member's population, every row to be committed
+    void store(Population &population, int r){
+        fromLane(new_weights, population.new_weights, r);
+        fromLane(new_weight_scale, population.new_weight_scale, r);
+        fromLane(new_strats, population.new_strats, r);
+        fromLane(new_strat_scale, population.new_strat_scale, r);
+        fromLane(new_score, population.new_score, r);
+        fromLane(total_payoff, population.total_payoff, r);
+        fromLane(interactions, population.interactions, r);
+        for(int agent = 0; agent < pop; agent++){
+            population.markRowDirty(agent);
+        }
+    }
+
+    template<class Rank>
+    void commit(){
+        std::copy(new_weights.begin(), new_weights.end(), cur_weights.begin());
+        std::copy(new_weight_scale.begin(), new_weight_scale.end(), cur_weight_scale.begin());
+        std::copy(new_strats.begin(), new_strats.end(), cur_strats.begin());
+        std::copy(new_strat_scale.begin(), new_strat_scale.end(), cur_strat_scale.begin());
+        std::copy(new_score.begin(), new_score.end(), cur_score.begin());
+        for(int i = 0; i < pop * LANES; i++){
+            Rank::commitScore(*this, i);
+        }
+    }
+};
+
+// Block 0 of every replica's counter stream (seed, t, agent, purpose), as the stream's
+// first two draws
+static inline void lane_draws(const uint32_t *seeds, uint32_t t, uint32_t agent, uint32_t purpose, double *first, double *second){
+    const uint32_t ctr[4] = {t, agent, purpose, 0};
+    for(int r = 0; r < LANES; r++){
+        uint32_t x[4];
+        CounterStream::philox(seeds[r], ctr, x);
+        first[r] = CounterStream::uniform(x[0], x[1]);
+        second[r] = CounterStream::uniform(x[2], x[3]);
+    }
+}
+
+// Agent::drawStrategy on the two draws of its stream
+static inline int lane_strategy(double tremble_draw, double weight_draw, float strategy_tremble, double strat_0, double strat_1){
+    if(tremble_draw < strategy_tremble){
+        return (int) (weight_draw + 0.5);
+    }
+    double strat_sum_1 = strat_0 + strat_1;
+    return weight_draw * strat_sum_1 < strat_0 ? 0 : 1;
+}
+
+#ifdef WEIGHT_FLOOR
+// Agent.cpp's floorWeights over one replica's entries
+static void floor_lane(weight_t *weights, int count){
+    double total = 0.0;
+    for(int i = 0; i < count; i++){
+        total = total + weights[i * LANES];
+    }
+    double floor = WEIGHT_FLOOR * total;
+    for(int i = 0; i < count; i++){
+        if(weights[i * LANES] < floor){
+            weights[i * LANES] = 0;
+        }
+    }
+}
+#endif
+
+// Agent's learning steps on one replica (entries of replica r), same arithmetic
+class LaneAgent{
+    public:
+        LaneAgent(EnsembleState &state, const LearningParams &params, int agent, int r) : state(state), params(params), agent(agent), r(r) {}
+
+        void discountStrategy(int role){
+            double &scale = state.new_strat_scale[(agent * 2 + role) * LANES + r];
+            scale = scale * (1-params.strategy_discount);
+
+            if(scale < DISCOUNT_RENORM_SCALE){
+                weight_t *new_strats = &state.new_strats[(agent * 2 + role) * 2 * LANES + r];
+                weight_t factor = scale;
+                new_strats[0] = new_strats[0] * factor;
+                new_strats[LANES] = new_strats[LANES] * factor;
+                #ifdef WEIGHT_FLOOR
+                    floor_lane(new_strats, 2);
+                #endif
+                scale = 1;
+            }
+        }
+
+        void discountNeighbors(){
+            double &scale = state.new_weight_scale[agent * LANES + r];
+            scale = scale * (1-params.network_discount);
+
+            if(scale < DISCOUNT_RENORM_SCALE){
+                weight_t *new_friends = &state.new_weights[(size_t) agent * state.pop * LANES + r];
+                for(int nid = 0; nid < state.pop; nid++){
+                    new_friends[nid * LANES] = new_friends[nid * LANES] * scale;
+                }
+                #ifdef WEIGHT_FLOOR
+                    floor_lane(new_friends, state.pop);
+                #endif
+                scale = 1;
+            }
+        }
+
+        void updateInteractions(int inter_number){
+            state.interactions[(agent * 4 + inter_number) * LANES + r]++;
+        }
+
+        void addNetworkPayoff(int partner, double payoff){
+            double scale = state.new_weight_scale[agent * LANES + r];
+            weight_t &weight = state.new_weights[((size_t) agent * state.pop + partner) * LANES + r];
+            weight = weight + payoff * params.network_learning_speed / scale;
+        }
+
+        template<class Rank>
+        void addStrategyPayoff(int role, int strategy, double payoff){
+            double scale = state.new_strat_scale[(agent * 2 + role) * LANES + r];
+            weight_t &weight = state.new_strats[((agent * 2 + role) * 2 + strategy) * LANES + r];
+            weight = weight + payoff * params.strategy_learning_speed / scale;
+
+            double *payoffs = Rank::payoffs(state);
+            payoffs[agent * LANES + r] = payoffs[agent * LANES + r] + payoff;
+        }
+
+    private:
+        EnsembleState &state;
+        const LearningParams &params;
+        int agent;
+        int r;
+};
+
+// One step of every replica: shuffle, draws and payoffs across the replicas, then each
+// replica's updates in its shuffled order (update_visitor and update_host of the driver)
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_ensemble_timestep(Game &g, EnsembleState &state, const LearningParams &params, const uint32_t *seeds, int t, InteractionBatch &batch){
+    int pop = state.pop;
+
+    for(int r = 0; r < LANES; r++){
+        int *agent_seq = &state.agent_seq[r * pop];
+        std::iota(agent_seq, agent_seq + pop, 0);
+        CounterStream shuffle_rng(seeds[r], t, 0, DRAW_SHUFFLE);
+        std::random_shuffle(agent_seq, agent_seq + pop, [&shuffle_rng](int n){ return (int) (shuffle_rng() * n); });
+        for(int i = 0; i < pop; i++){
+            state.seq_pos[r * pop + agent_seq[i]] = i;
+        }
+    }
+
+    // Draw phase, agent by agent for all replicas; interaction a * LANES + r is agent a's
+    // visit in replica r
+    for(int a = 0; a < pop; a++){
+        double first[LANES];
+        double second[LANES];
+
+        // Partner: ScanSampler's sum and count over the committed rows
+        lane_draws(seeds, t, a, DRAW_PARTNER, first, second);
+        const weight_t *row = &state.cur_weights[(size_t) a * pop * LANES];
+        double total[LANES] = {0};
+        for(int nid = 0; nid < pop; nid++){
+            for(int r = 0; r < LANES; r++){
+                total[r] += row[nid * LANES + r];
+            }
+        }
+        double target[LANES];
+        for(int r = 0; r < LANES; r++){
+            target[r] = second[r] * total[r];
+        }
+        double running_sum[LANES] = {0};
+        int count[LANES] = {0};
+        for(int nid = 0; nid < pop; nid++){
+            for(int r = 0; r < LANES; r++){
+                running_sum[r] += row[nid * LANES + r];
+                count[r] += (running_sum[r] < target[r]);
+            }
+        }
+
+        // Trembles take a uniform other agent by shuffled position (chooseFixedFriend)
+        for(int r = 0; r < LANES; r++){
+            float rand_tremble = first[r];
+            int friend_ind;
+            if(rand_tremble > params.network_tremble){
+                friend_ind = count[r] == a ? a + 1 : count[r];
+                if(friend_ind >= pop){
+                    friend_ind = -1;
+                }
+            }else{
+                int temp_friend_ind = (int) (second[r] * (pop-1));
+                if(temp_friend_ind >= state.seq_pos[r * pop + a]){
+                    temp_friend_ind++;
+                }
+                friend_ind = state.agent_seq[r * pop + temp_friend_ind];
+            }
+            batch.host[a * LANES + r] = friend_ind;
+        }
+
+        lane_draws(seeds, t, a, DRAW_VISIT_STRATEGY, first, second);
+        for(int r = 0; r < LANES; r++){
+            const weight_t *strats = &state.cur_strats[a * 4 * LANES + r];
+            batch.visit_strategy[a * LANES + r] = lane_strategy(first[r], second[r], params.strategy_tremble, strats[0], strats[LANES]);
+        }
+
+        lane_draws(seeds, t, a, DRAW_HOST_STRATEGY, first, second);
+        for(int r = 0; r < LANES; r++){
+            int host = batch.host[a * LANES + r];
+            const weight_t *strats = &state.cur_strats[(host * 4 + 2) * LANES + r];
+            batch.host_strategy[a * LANES + r] = lane_strategy(first[r], second[r], params.strategy_tremble, strats[0], strats[LANES]);
+        }
+
+        for(int r = 0; r < LANES; r++){
+            int host = batch.host[a * LANES + r];
+            batch.visit_score[a * LANES + r] = state.cur_score[a * LANES + r];
+            batch.host_score[a * LANES + r] = state.cur_score[host * LANES + r];
+            batch.visit_key[a * LANES + r] = state.bonus_cache.score_key[a * LANES + r];
+            batch.host_key[a * LANES + r] = state.bonus_cache.score_key[host * LANES + r];
+        }
+
+        if(Coupling::uses_draw){
+            lane_draws(seeds, t, a, DRAW_COUPLING, first, second);
+            std::copy(first, first + LANES, &batch.draw[a * LANES]);
+        }
+    }
+
+    // Payoff phase
+    g.playBatch<Coupling>(batch, 0, pop * LANES);
+
+    // Update phase, replica by replica (interactions in shuffled order)
+    for(int r = 0; r < LANES; r++){
+        for(int i = 0; i < pop; i++){
+            int visitor = state.agent_seq[r * pop + i];
+            int entry = visitor * LANES + r;
+            int host = batch.host[entry];
+            int visit_strategy = batch.visit_strategy[entry];
+            int host_strategy = batch.host_strategy[entry];
+            int inter_number = 2 * visit_strategy + host_strategy;
+
+            LaneAgent currentAgent(state, params, visitor, r);
+            if(NetLearn){
+                currentAgent.discountNeighbors();
+            }
+            currentAgent.discountStrategy(0);
+            if(Rank::discount_idle_role){
+                currentAgent.discountStrategy(1);
+            }
+            currentAgent.updateInteractions(inter_number);
+            if(NetLearn){
+                currentAgent.addNetworkPayoff(host, batch.visit_payoff[entry]);
+            }
+            currentAgent.addStrategyPayoff<Rank>(0, visit_strategy, batch.visit_payoff[entry]);
+            if(StratSym){
+                currentAgent.discountStrategy(1);
+                currentAgent.addStrategyPayoff<Rank>(1, visit_strategy, batch.visit_payoff[entry]);
+            }
+
+            LaneAgent friendAgent(state, params, host, r);
+            friendAgent.discountStrategy(1);
+            if(Rank::discount_idle_role){
+                friendAgent.discountStrategy(0);
+            }
+            friendAgent.updateInteractions(inter_number);
+            if(NetLearn && NetSym){
+                friendAgent.discountNeighbors();
+                friendAgent.addNetworkPayoff(visitor, batch.host_payoff[entry]);
+            }
+            friendAgent.addStrategyPayoff<Rank>(1, host_strategy, batch.host_payoff[entry]);
+            if(StratSym){
+                friendAgent.discountStrategy(0);
+                friendAgent.addStrategyPayoff<Rank>(0, host_strategy, batch.host_payoff[entry]);
+            }
+        }
+    }
+}
+
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_ensemble_kernel(Game &g, std::vector<EnsembleMember> &members){
+    int active = (int) members.size();
+    Network &first_net = *members[0].net;
+    int pop = first_net.getPop();
+
+    LearningParams params(first_net.GetAgent(0));
+
+    for(int m = 0; m < active; m++){
+        EnsembleMember &member = members[m];
+        member.tracking_vars->initTrackLocation<Rank>(*member.net, *member.rng, *member.nrng);
+    }
+
+    // Replicas past the last member repeat the first one and are never recorded
+    EnsembleState state;
+    state.init(pop);
+    uint32_t seeds[LANES];
+    for(int r = 0; r < LANES; r++){
+        EnsembleMember &member = members[r < active ? r : 0];
+        state.load(member.net->getPopulation(), r);
+        seeds[r] = member.tracking_vars->stream_seed;
+    }
+    state.bonus_cache.setTransform(&Coupling::scoreKey, state.cur_score);
+
+    // Members' own caches, used by their tracker commits
+    for(int m = 0; m < active; m++){
+        Population &population = members[m].net->getPopulation();
+        population.bonus_cache.setTransform(&Coupling::scoreKey, population.cur_score);
+    }
+
+    InteractionBatch batch;
+    batch.init(pop * LANES, 2);
+
+    SimTracking &first_tracking = *members[0].tracking_vars;
+    for(int t = 1; t < first_tracking.max_time+1; t++){
+        run_ensemble_timestep<Rank, Coupling, NetLearn, NetSym, StratSym>(g, state, params, seeds, t, batch);
+
+        // Recorded steps hand each member its replica's step, which it commits and records
+        if(first_tracking.isRecorded<Rank>(t)){
+            for(int m = 0; m < active; m++){
+                EnsembleMember &member = members[m];
+                state.store(member.net->getPopulation(), m);
+                for(int agent = 0; agent < pop; agent++){
+                    Agent &curAgent = member.net->GetAgent(agent);
+                    int entry = agent * LANES + m;
+                    curAgent.setCurrentFriend(batch.host[entry]);
+                    curAgent.recordInteraction(batch.visit_payoff[entry], batch.host_payoff[entry]);
+                }
+                member.tracking_vars->updateData<Rank>(*member.net, *member.rng, *member.nrng, t);
+            }
+        }
+        state.commit<Rank>();
+    }
+}
+
+// Pick the kernel for the key's learning configuration (as CoupledModel)
+template<class Rank, class Coupling>
+struct EnsembleModel{
+    static void run(Game &g, std::vector<EnsembleMember> &members){
+        LearningParams params(members[0].net->GetAgent(0));
+
+        if(!params.net_learn){
+            if(params.strat_sym){
+                run_ensemble_kernel<Rank, Coupling, false, false, true>(g, members);
+            }else{
+                run_ensemble_kernel<Rank, Coupling, false, false, false>(g, members);
+            }
+        }else if(params.net_sym){
+            if(params.strat_sym){
+                run_ensemble_kernel<Rank, Coupling, true, true, true>(g, members);
+            }else{
+                run_ensemble_kernel<Rank, Coupling, true, true, false>(g, members);
+            }
+        }else{
+            if(params.strat_sym){
+                run_ensemble_kernel<Rank, Coupling, true, false, true>(g, members);
+            }else{
+                run_ensemble_kernel<Rank, Coupling, true, false, false>(g, members);
+            }
+        }
+    }
+};
+
+void run_ensemble(Game &g, std::vector<EnsembleMember> &members, RankModel rank_model){
+    if(members.empty() || (int) members.size() > LANES){
+        std::cerr << "Error: an ensemble runs 1 to " << LANES << " seeds\n";
+        _Exit(1);
+    }
+    dispatch_model<EnsembleModel>(rank_model, g, g, members);
+}
+#endif
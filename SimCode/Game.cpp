@@ -0,0 +1,144 @@
+/* The Network class Implementation (Network).cpp) */
+#include "Network.h" // user-defined header in the same directory
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <iterator>
+#include <math.h>
+#include <numeric>
+
+// Constructor
+// default values shall only be specified in the declaration,
+// cannot be repeated in definition
+Game::Game(std::vector<std::vector<double>> gamePayoffs,std::string gameName, double base_payoff, std::vector<int> num_strats, std::string coupling_effect, std::vector<double> fight_bonus){
+    this->gamePayoffs = gamePayoffs;
+    this->gameName = gameName;
+    this->base_payoff = base_payoff;
+    this->num_strats = num_strats;
+    this->coupling_effect = coupling_effect;
+    this->fight_bonus = fight_bonus;
+    
+    setTables();
+}
+Game::Game(std::string payoff_filepath, std::string gameName, double base_payoff, std::string coupling_effect){
+    this->gameName = gameName;
+    this->base_payoff = base_payoff;
+    this->coupling_effect = coupling_effect;
+
+    std::ifstream infile(payoff_filepath);
+    
+    std::string line;
+    
+    int i = 0;
+    
+    while (std::getline(infile, line))
+    {
+        std::istringstream iss(line);
+                
+        if(i == 0){
+            std::istream_iterator<int> start(iss), end;
+            std::vector<int> this_line(start, end);
+            num_strats = this_line;
+        }else if(i < 3){
+            std::istream_iterator<double> start(iss), end;
+            std::vector<double> this_line(start, end);
+            gamePayoffs.push_back(this_line);
+        }else{
+            std::istream_iterator<double> start(iss), end;
+            std::vector<double> this_line(start, end);
+            fight_bonus = this_line;
+        }
+        i++;
+    }
+    
+    setTables();
+}
+
+CouplingType parseCoupling(const std::string &coupling_effect){
+    if(coupling_effect == "Fight"){
+        return COUPLING_FIGHT;
+    }else if(coupling_effect == "FightSplit"){
+        return COUPLING_FIGHTSPLIT;
+    }else if(coupling_effect == "FightRand"){
+        return COUPLING_FIGHTRAND;
+    }else if(coupling_effect == "StagHunt"){
+        return COUPLING_STAGHUNT;
+    }else if(coupling_effect == "FSH"){
+        return COUPLING_FSH;
+    }else if(coupling_effect == "None"){
+        return COUPLING_NONE;
+    }
+    return COUPLING_UNKNOWN;
+}
+
+// Resolve the coupling name and copy the payoffs into flat tables (once, not per interaction)
+void Game::setTables(){
+    coupling_type = parseCoupling(coupling_effect);
+    
+    // Both roles choose among the same k strategies, and each role's payoffs are a k x k table
+    if(num_strats.size() != 2 || num_strats.at(0) < 2 || num_strats.at(1) != num_strats.at(0)){
+        std::cerr << "Error: the game needs the same number (at least 2) of strategies for both roles\n";
+        _Exit(1);
+    }
+    strategies = num_strats.at(0);
+    
+    for(int role = 0; role < 2; role++){
+        if((int) gamePayoffs.size() <= role || (int) gamePayoffs.at(role).size() != strategies * strategies){
+            std::cerr << "Error: a game of " << strategies << " strategies needs " << strategies * strategies << " payoffs per role\n";
+            _Exit(1);
+        }
+        payoff_table[role].assign(gamePayoffs.at(role).begin(), gamePayoffs.at(role).end());
+    }
+    
+    // Couplings read {winner bonus, tie bonus}, absent entries count as no bonus
+    if(fight_bonus.size() < 2){
+        fight_bonus.resize(2, 0.0);
+    }
+}
+
+std::string Game::getName(){
+    return gameName;
+}
+
+std::string Game::getCouplingEffect(){
+    return coupling_effect;
+}
+
+CouplingType Game::getCouplingType(){
+    return coupling_type;
+}
+
+void Game::setPayoffs(std::vector<std::vector<double>> gamePayoffs){
+    this->gamePayoffs = gamePayoffs;
+    setTables();
+}
+
+const std::vector<std::vector<double>>& Game::getPayoffs(){
+    return gamePayoffs;
+}
+
+double Game::getBasePayoff(){
+    return base_payoff;
+};
+
+const std::vector<int>& Game::getNumStrats(){
+    return num_strats;
+}
+
+std::array<double,2> Game::playGame(UGenerator &rng, Agent &visitor, Agent &host){
+    switch(coupling_type){
+        case COUPLING_FIGHT:
+            return play<FightCoupling>(rng, visitor, host);
+        case COUPLING_FIGHTSPLIT:
+            return play<FightSplitCoupling>(rng, visitor, host);
+        case COUPLING_FIGHTRAND:
+            return play<FightRandCoupling>(rng, visitor, host);
+        case COUPLING_STAGHUNT:
+            return play<StagHuntCoupling>(rng, visitor, host);
+        case COUPLING_FSH:
+            return play<FSHCoupling>(rng, visitor, host);
+        default:
+            return play<NoCoupling>(rng, visitor, host);
+    }
+}
@@ -0,0 +1,486 @@
+/* The mean-field solver (MeanField.cpp), built with -DMEAN_FIELD=tol */
+#ifdef MEAN_FIELD
+#include "Network.h" // user-defined header in the same directory
+#include <iostream>
+#include <numeric>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+// Share of a uses_draw coupling's interactions played as with draw 0 rather than draw 1.
+// FightRand's draw only decides whether the visitor wins, with probability visitKey over
+// the keys' sum (when both are 0 the exact kernel's comparison is false, so the host wins).
+template<class Coupling>
+struct DrawShare{
+    static double of(double visit_key, double host_key){
+        return 1;
+    }
+};
+template<>
+struct DrawShare<FightRandCoupling>{
+    static double of(double visit_key, double host_key){
+        double total = visit_key + host_key;
+        return total > 0 ? visit_key / total : 0;
+    }
+};
+
+// The expected dynamics as an ODE in time (in timesteps). The state holds the true network
+// weights (in the population's row order), the strategy weights, the rank's cumulative
+// payoffs and the expected interaction counts. Its rate is the expected change of one
+// exact timestep: each weight vector decays at -log(1 - discount) per expected discount
+// and gains every expected payoff reinforced into it.
+template<class Coupling>
+struct FieldSystem{
+    Population &population;
+    Game &g;
+    LearningParams params;
+    bool payoff_scores; // Scores follow the cumulative payoffs (dynamic ranks)
+    int cross_discounts; // Discounts of the other role's strategies per interaction, as apply_leap
+
+    // Offsets of each block of the state
+    size_t strat_at;
+    size_t payoff_at;
+    size_t count_at;
+    size_t size;
+
+    // Network state index of each link's way back, for symmetric network learning
+    std::vector<size_t> reverse;
+
+    // Choice probabilities and expected hostings per step at the state last evaluated
+    std::vector<double> visit_prob; // One per link
+    std::vector<double> strat_prob; // pop x num_roles x num_strats
+    std::vector<double> hosted; // pop
+    std::vector<double> score;
+    std::vector<double> score_key;
+
+    // Expected payoffs of each agent's visit per step, to the visitor and to its host
+    std::vector<double> visit_payoff;
+    std::vector<double> host_payoff;
+
+    // Every (link, visitor strategy, host strategy, draw) cell, at cell index
+    // ((link * num_strats + a) * num_strats + b) * sides + side, with its payoffs from
+    // Game::playBatch.  They are replayed only when the scores move (dynamic ranks).
+    static const int sides = Coupling::uses_draw ? 2 : 1;
+    InteractionBatch batch;
+    bool played;
+
+    FieldSystem(Population &population, Game &g, const LearningParams &params, bool payoff_scores, int cross_discounts) : population(population), g(g), params(params), payoff_scores(payoff_scores), cross_discounts(cross_discounts){
+        int pop = population.pop;
+        int roles = population.num_roles;
+        int num_strats = population.num_strats;
+        size_t num_weights = population.cur_weights.size();
+
+        strat_at = num_weights;
+        payoff_at = strat_at + (size_t) pop * roles * num_strats;
+        count_at = payoff_at + pop;
+        size = count_at + (size_t) pop * population.num_interactions;
+
+        if(params.net_sym){
+            reverse.assign(num_weights, 0);
+            for(int agent = 0; agent < pop; agent++){
+                for(int column = 0; column < population.rowLength(agent); column++){
+                    int partner = population.partnerAt(agent, column);
+                    reverse[population.rowStart(agent) + column] = population.rowStart(partner) + population.columnOf(partner, agent);
+                }
+            }
+        }
+
+        visit_prob.assign(num_weights, 0.0);
+        strat_prob.assign((size_t) pop * roles * num_strats, 0.0);
+        hosted.assign(pop, 0.0);
+        score.assign(population.cur_score.begin(), population.cur_score.end());
+        score_key.assign(population.bonus_cache.score_key.begin(), population.bonus_cache.score_key.end());
+        visit_payoff.assign(pop, 0.0);
+        host_payoff.assign(pop, 0.0);
+
+        size_t cells = num_weights * num_strats * num_strats * sides;
+        batch.size = (int) cells;
+        batch.num_strats = num_strats;
+        batch.host.assign(cells, 0);
+        batch.visit_strategy.assign(cells, 0);
+        batch.host_strategy.assign(cells, 0);
+        batch.visit_score.assign(cells, 0.0);
+        batch.host_score.assign(cells, 0.0);
+        batch.visit_key.assign(cells, 0.0);
+        batch.host_key.assign(cells, 0.0);
+        batch.draw.assign(cells, 0.0);
+        batch.visit_payoff.assign(cells, 0.0);
+        batch.host_payoff.assign(cells, 0.0);
+        size_t cell = 0;
+        for(int agent = 0; agent < pop; agent++){
+            for(int column = 0; column < population.rowLength(agent); column++){
+                for(int a = 0; a < num_strats; a++){
+                    for(int b = 0; b < num_strats; b++){
+                        for(int side = 0; side < sides; side++){
+                            batch.host[cell] = population.partnerAt(agent, column);
+                            batch.visit_strategy[cell] = a;
+                            batch.host_strategy[cell] = b;
+                            batch.draw[cell] = side;
+                            cell++;
+                        }
+                    }
+                }
+            }
+        }
+        played = false;
+    }
+
+    // The population's committed state
+    void initState(std::vector<double> &y, const double *payoffs){
+        int pop = population.pop;
+        int roles = population.num_roles;
+        int num_strats = population.num_strats;
+        y.assign(size, 0.0);
+        for(int agent = 0; agent < pop; agent++){
+            const weight_t *friends = population.curFriends(agent);
+            size_t row = population.rowStart(agent);
+            for(int column = 0; column < population.rowLength(agent); column++){
+                y[row + column] = friends[column] * population.cur_weight_scale[agent];
+            }
+            for(int role = 0; role < roles; role++){
+                const weight_t *strats = population.curStrats(agent, role);
+                for(int s = 0; s < num_strats; s++){
+                    y[strat_at + ((size_t) agent * roles + role) * num_strats + s] = strats[s] * population.cur_strat_scale[agent * roles + role];
+                }
+            }
+            y[payoff_at + agent] = payoffs[agent];
+            const int *counts = population.agentInteractions(agent);
+            for(int k = 0; k < population.num_interactions; k++){
+                y[count_at + (size_t) agent * population.num_interactions + k] = counts[k];
+            }
+        }
+    }
+
+    // Choice probabilities at state y, as drawn: by weight, or uniform after a tremble
+    void probabilities(const std::vector<double> &y){
+        int pop = population.pop;
+        int roles = population.num_roles;
+        int num_strats = population.num_strats;
+        bool complete = population.substrate.complete();
+
+        for(int agent = 0; agent < pop; agent++){
+            for(int role = 0; role < roles; role++){
+                size_t entry = ((size_t) agent * roles + role) * num_strats;
+                double strat_sum = 0;
+                for(int s = 0; s < num_strats; s++){
+                    strat_sum += std::max(0.0, y[strat_at + entry + s]);
+                }
+                for(int s = 0; s < num_strats; s++){
+                    double weighted = strat_sum > 0 ? std::max(0.0, y[strat_at + entry + s]) / strat_sum : 1.0 / num_strats;
+                    strat_prob[entry + s] = params.strategy_tremble / num_strats + (1 - params.strategy_tremble) * weighted;
+                }
+            }
+        }
+
+        std::fill(hosted.begin(), hosted.end(), 0.0);
+        for(int agent = 0; agent < pop; agent++){
+            int row_len = population.rowLength(agent);
+            int others = complete ? pop - 1 : row_len;
+            size_t row = population.rowStart(agent);
+            double net_sum = 0;
+            for(int column = 0; column < row_len; column++){
+                net_sum += std::max(0.0, y[row + column]);
+            }
+            for(int column = 0; column < row_len; column++){
+                if(complete && column == agent){
+                    visit_prob[row + column] = 0;
+                    continue;
+                }
+                double weighted = net_sum > 0 ? std::max(0.0, y[row + column]) / net_sum : 1.0 / others;
+                visit_prob[row + column] = params.network_tremble / others + (1 - params.network_tremble) * weighted;
+                hosted[population.partnerAt(agent, column)] += visit_prob[row + column];
+            }
+        }
+
+        if(payoff_scores){
+            for(int agent = 0; agent < pop; agent++){
+                score[agent] = y[payoff_at + agent];
+                score_key[agent] = population.bonus_cache.transform(score[agent]);
+            }
+        }
+    }
+
+    // Payoffs of every cell at the current scores
+    void playCells(){
+        if(played && !payoff_scores){
+            return;
+        }
+        size_t per_link = (size_t) population.num_strats * population.num_strats * sides;
+        size_t cell = 0;
+        for(int agent = 0; agent < population.pop; agent++){
+            size_t row_cells = population.rowLength(agent) * per_link;
+            for(size_t c = cell; c < cell + row_cells; c++){
+                int host = batch.host[c];
+                batch.visit_score[c] = score[agent];
+                batch.host_score[c] = score[host];
+                batch.visit_key[c] = score_key[agent];
+                batch.host_key[c] = score_key[host];
+            }
+            cell += row_cells;
+        }
+        g.playBatch<Coupling>(batch, 0, batch.size);
+        played = true;
+    }
+
+    // dy = rate of the expected dynamics at state y
+    void derivative(const std::vector<double> &y, std::vector<double> &dy){
+        int pop = population.pop;
+        int roles = population.num_roles;
+        int num_strats = population.num_strats;
+        int num_inter = population.num_interactions;
+        double network_decay = -std::log(1.0 - params.network_discount);
+        double strategy_decay = -std::log(1.0 - params.strategy_discount);
+        double score_share = params.strat_sym ? 2 : 1; // As apply_leap: symmetric strategies score twice
+        double net_speed = params.network_learning_speed;
+        double strat_speed = params.strategy_learning_speed;
+
+        probabilities(y);
+        playCells();
+        dy.assign(size, 0.0);
+
+        const double *cell_visit = batch.visit_payoff.data();
+        const double *cell_host = batch.host_payoff.data();
+        for(int agent = 0; agent < pop; agent++){
+            size_t row = population.rowStart(agent);
+            const double *visit_strat = &strat_prob[(size_t) agent * roles * num_strats];
+            double visit_total = 0;
+            double host_total = 0;
+            for(int column = 0; column < population.rowLength(agent); column++){
+                size_t link = row + column;
+                double link_prob = visit_prob[link];
+                if(!(link_prob > 0)){
+                    continue;
+                }
+                int host = population.partnerAt(agent, column);
+                const double *host_strat = &strat_prob[((size_t) host * roles + 1) * num_strats];
+                double share = DrawShare<Coupling>::of(score_key[agent], score_key[host]);
+                size_t cell = link * num_strats * num_strats * sides;
+                double link_visit = 0;
+                double link_host = 0;
+                for(int a = 0; a < num_strats; a++){
+                    for(int b = 0; b < num_strats; b++){
+                        double chance = link_prob * visit_strat[a] * host_strat[b];
+                        double visit_gain = 0;
+                        double host_gain = 0;
+                        for(int side = 0; side < sides; side++, cell++){
+                            double side_chance = side == 0 ? share : 1 - share;
+                            visit_gain += side_chance * cell_visit[cell];
+                            host_gain += side_chance * cell_host[cell];
+                        }
+                        visit_gain *= chance;
+                        host_gain *= chance;
+
+                        dy[strat_at + ((size_t) agent * roles) * num_strats + a] += strat_speed * visit_gain;
+                        dy[strat_at + ((size_t) host * roles + 1) * num_strats + b] += strat_speed * host_gain;
+                        if(params.strat_sym){
+                            dy[strat_at + ((size_t) agent * roles + 1) * num_strats + a] += strat_speed * visit_gain;
+                            dy[strat_at + ((size_t) host * roles) * num_strats + b] += strat_speed * host_gain;
+                        }
+                        dy[count_at + (size_t) agent * num_inter + a * num_strats + b] += chance;
+                        dy[count_at + (size_t) host * num_inter + a * num_strats + b] += chance;
+
+                        link_visit += visit_gain;
+                        link_host += host_gain;
+                    }
+                }
+
+                if(params.net_learn){
+                    dy[link] += net_speed * link_visit;
+                    if(params.net_sym){
+                        dy[reverse[link]] += net_speed * link_host;
+                    }
+                }
+                dy[payoff_at + host] += score_share * link_host;
+                visit_total += link_visit;
+                host_total += link_host;
+            }
+            dy[payoff_at + agent] += score_share * visit_total;
+            visit_payoff[agent] = visit_total;
+            host_payoff[agent] = host_total;
+        }
+
+        // Discounts per step: the agent's visit, and its expected hostings
+        for(int agent = 0; agent < pop; agent++){
+            if(params.net_learn){
+                double rate = network_decay * (1 + (params.net_sym ? hosted[agent] : 0));
+                size_t row = population.rowStart(agent);
+                for(int column = 0; column < population.rowLength(agent); column++){
+                    dy[row + column] -= rate * y[row + column];
+                }
+            }
+            for(int role = 0; role < roles; role++){
+                double events = role == 0 ? 1 + hosted[agent] * cross_discounts : hosted[agent] + cross_discounts;
+                size_t entry = strat_at + ((size_t) agent * roles + role) * num_strats;
+                for(int s = 0; s < num_strats; s++){
+                    dy[entry + s] -= strategy_decay * events * y[entry + s];
+                }
+            }
+        }
+    }
+};
+
+// Dormand-Prince 5(4) tableau: stage nodes are implied by the rows, the last row is the
+// fifth-order solution (and the first stage of the next step), err the difference to the
+// embedded fourth-order one
+static const double dp_a[6][6] = {
+    {1.0/5},
+    {3.0/40, 9.0/40},
+    {44.0/45, -56.0/15, 32.0/9},
+    {19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729},
+    {9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656},
+    {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84}
+};
+static const double dp_err[7] = {71.0/57600, 0, -71.0/16695, 71.0/1920, -17253.0/339200, 22.0/525, -1.0/40};
+
+// Error below which a weight near 0 is not resolved any further (far below any weight
+// that moves a choice probability, as trembles keep every link and strategy in play)
+static const double field_abs_tol = 1e-6;
+
+// Adaptive Runge-Kutta integration of the expected dynamics
+template<class Coupling>
+struct FieldIntegrator{
+    FieldSystem<Coupling> &system;
+    std::vector<std::vector<double>> k; // Stage rates, k[0] the rate at y
+    std::vector<double> stage;
+    std::vector<double> next;
+    double h; // Next step size to try
+
+    FieldIntegrator(FieldSystem<Coupling> &system, const std::vector<double> &y) : system(system), k(7), h(1){
+        system.derivative(y, k[0]);
+    }
+
+    // Advance y from time t to until, in steps of relative error at most MEAN_FIELD.  The
+    // last rate evaluated is the one at the accepted y, so the system's probabilities and
+    // visit payoffs are those of y afterwards.
+    void advance(std::vector<double> &y, double &t, double until){
+        size_t size = y.size();
+        while(t < until){
+            bool last = h >= until - t;
+            double step = last ? until - t : h;
+
+            for(int s = 1; s < 7; s++){
+                stage.assign(y.begin(), y.end());
+                for(int r = 0; r < s; r++){
+                    double a = dp_a[s - 1][r] * step;
+                    if(a == 0){
+                        continue;
+                    }
+                    const double *rate = k[r].data();
+                    for(size_t i = 0; i < size; i++){
+                        stage[i] += a * rate[i];
+                    }
+                }
+                if(s == 6){
+                    next.swap(stage);
+                }
+                system.derivative(s == 6 ? next : stage, k[s]);
+            }
+
+            double err = 0;
+            for(size_t i = 0; i < size; i++){
+                double e = 0;
+                for(int s = 0; s < 7; s++){
+                    e += dp_err[s] * k[s][i];
+                }
+                double bound = field_abs_tol + MEAN_FIELD * std::max(std::fabs(y[i]), std::fabs(next[i]));
+                err = std::max(err, std::fabs(e * step) / bound);
+            }
+
+            // Steps at MEAN_FIELD_MIN_STEP go through regardless, so a payoff that jumps
+            // (ranks crossing under Fight) cannot stall the run
+            if(err <= 1 || step <= MEAN_FIELD_MIN_STEP){
+                y.swap(next);
+                k[0].swap(k[6]);
+                t = last ? until : t + step;
+            }
+            double grow = err > 0 ? 0.9 * std::pow(err, -0.2) : 5;
+            double tried = std::max(step * std::min(5.0, std::max(0.2, grow)), (double) MEAN_FIELD_MIN_STEP);
+            if(!(last && err <= 1)){
+                h = tried;
+            }
+        }
+    }
+};
+
+// Copy state y into the population, for updateData to commit and record: the weights,
+// the rank's payoffs, the expected interaction counts (rounded), and as the last visit
+// each agent's most likely partner with its visit's expected payoffs
+template<class Rank, class Coupling>
+static void write_state(Network &net, FieldSystem<Coupling> &system, const std::vector<double> &y){
+    Population &population = net.getPopulation();
+    int pop = population.pop;
+    int roles = population.num_roles;
+    int num_strats = population.num_strats;
+    double *payoffs = Rank::payoffs(population);
+    std::vector<double> friends(pop, 0.0);
+    std::vector<double> strats(num_strats, 0.0);
+
+    for(int agent = 0; agent < pop; agent++){
+        Agent &curAgent = net.GetAgent(agent);
+        size_t row = population.rowStart(agent);
+        int row_len = population.rowLength(agent);
+
+        if(system.params.net_learn){
+            for(int column = 0; column < row_len; column++){
+                friends[population.partnerAt(agent, column)] = std::max(0.0, y[row + column]);
+            }
+            curAgent.setFriends(friends);
+        }
+        for(int role = 0; role < roles; role++){
+            for(int s = 0; s < num_strats; s++){
+                strats[s] = std::max(0.0, y[system.strat_at + ((size_t) agent * roles + role) * num_strats + s]);
+            }
+            curAgent.setStrats(role, strats);
+        }
+
+        payoffs[agent] = y[system.payoff_at + agent];
+        int *counts = population.agentInteractions(agent);
+        for(int k = 0; k < population.num_interactions; k++){
+            counts[k] = (int) std::llround(y[system.count_at + (size_t) agent * population.num_interactions + k]);
+        }
+
+        const double *link = &system.visit_prob[row];
+        int likely = (int) (std::max_element(link, link + row_len) - link);
+        curAgent.setCurrentFriend(population.partnerAt(agent, likely));
+        curAgent.recordInteraction(system.visit_payoff[agent], system.host_payoff[agent]);
+    }
+}
+
+template<class Rank, class Coupling>
+struct FieldKernel{
+    static void run(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net);
+};
+
+template<class Rank, class Coupling>
+void FieldKernel<Rank, Coupling>::run(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net){
+    LearningParams params(net.GetAgent(0));
+
+    tracking_vars.initTrackLocation<Rank>(net, rng, nrng);
+
+    Population &population = net.getPopulation();
+    population.bonus_cache.setTransform(&Coupling::scoreKey, population.cur_score);
+
+    // Dynamic ranks score by their cumulative payoffs
+    bool payoff_scores = Rank::payoffs(population) == population.new_score.data();
+    int cross_discounts = (Rank::discount_idle_role ? 1 : 0) + (params.strat_sym ? 1 : 0);
+    FieldSystem<Coupling> system(population, g, params, payoff_scores, cross_discounts);
+
+    std::vector<double> y;
+    system.initState(y, Rank::payoffs(population));
+    FieldIntegrator<Coupling> integrator(system, y);
+
+    double t = 0;
+    for(int time_t = 1; time_t < tracking_vars.max_time+1; time_t++){
+        if(!tracking_vars.isRecorded<Rank>(time_t)){
+            continue;
+        }
+        integrator.advance(y, t, time_t);
+        write_state<Rank>(net, system, y);
+        tracking_vars.updateData<Rank>(net, rng, nrng, time_t);
+    }
+}
+
+void run_mean_field(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, RankModel rank_model){
+    dispatch_model<FieldKernel>(rank_model, g, rng, nrng, g, tracking_vars, net);
+}
+#endif
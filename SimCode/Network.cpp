@@ -9,18 +9,17 @@
 // Constructor
 // default values shall only be specified in the declaration,
 // cannot be repeated in definition
-Network::Network(int pop, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob){
+Network::Network(int pop, const std::vector<int> &num_strats, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob){
 
     this->pop = pop;
+    population.init(pop, num_strats);
+    
     double fill_value = 19.0/(pop-1);
     for(int i = 0; i < pop; i++){
-        Agent A(i,fill_value,strategy_learning_speed, network_learning_speed, strategy_discount, network_discount, strategy_tremble, network_tremble, strategy_sym, network_sym, score_copy_prob, copy_error, explore_prob);
+        Agent A(population,i,fill_value,strategy_learning_speed, network_learning_speed, strategy_discount, network_discount, strategy_tremble, network_tremble, strategy_sym, network_sym, score_copy_prob, copy_error, explore_prob);
         
-        // Create friend weights vector
-        std::vector<double> myfriends(pop);
-        std::fill(myfriends.begin(),myfriends.end(),fill_value);
-        myfriends.at(i) = 0;
-        A.setFriends(myfriends);
+        // Uniform friend weights
+        A.setUniformFriends(fill_value);
         
         A.updateAgent();
         
@@ -31,9 +30,10 @@ Network::Network(int pop, float strategy_learning_speed, float network_learning_
     }
 }
 
-Network::Network(int pop, std::string strat_filepath, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob){
+Network::Network(int pop, std::string strat_filepath, const std::vector<int> &num_strats, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob, const Substrate &substrate){
     
     this->pop = pop;
+    population.init(pop, num_strats, substrate);
     
     double net_fill = 19.0/(pop-1);
     
@@ -42,13 +42,10 @@ Network::Network(int pop, std::string strat_filepath, float strategy_learning_sp
     std::vector<double> strat_matrix(startstrat, endstrat);
         
     for(int i = 0; i < pop; i++){
-        Agent A(i,strat_matrix,strategy_learning_speed, network_learning_speed, strategy_discount, network_discount, strategy_tremble, network_tremble, strategy_sym, network_sym, score_copy_prob, copy_error, explore_prob);
+        Agent A(population,i,strat_matrix,strategy_learning_speed, network_learning_speed, strategy_discount, network_discount, strategy_tremble, network_tremble, strategy_sym, network_sym, score_copy_prob, copy_error, explore_prob);
         
-        // Create friend weights vector
-        std::vector<double> myfriends(pop);
-        std::fill(myfriends.begin(),myfriends.end(),net_fill);
-        myfriends.at(i) = 0;
-        A.setFriends(myfriends);
+        // Uniform friend weights, the same total over a substrate agent's neighbors
+        A.setUniformFriends(substrate.complete() ? net_fill : 19.0/substrate.degree(i));
         
         A.updateAgent();
         
@@ -59,7 +56,7 @@ Network::Network(int pop, std::string strat_filepath, float strategy_learning_sp
     }
 }
 
-Network::Network(std::string net_filepath, std::string strat_filepath, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob) {  
+Network::Network(std::string net_filepath, std::string strat_filepath, const std::vector<int> &num_strats, float strategy_learning_speed, float network_learning_speed, float strategy_discount, float network_discount, float strategy_tremble, float network_tremble, bool strategy_sym, bool network_sym, float score_copy_prob, float copy_error, float explore_prob) {  
 
     std::ifstream netstream(net_filepath);
     std::istream_iterator<double> startnet(netstream), endnet;
@@ -67,6 +64,7 @@ Network::Network(std::string net_filepath, std::string strat_filepath, float str
     std::cout << "Read " << net_matrix.size() << " numbers" << std::endl;
     
     this->pop = pow(net_matrix.size(),0.5);
+    population.init(pop, num_strats);
     
     // print the numbers to stdout
     std::cout << "numbers read in:\n";
@@ -79,7 +77,7 @@ Network::Network(std::string net_filepath, std::string strat_filepath, float str
     std::vector<double> strat_matrix(startstrat, endstrat);
     
     for(int i = 0; i < pop; i++){  
-        Agent A(i,strat_matrix,strategy_learning_speed, network_learning_speed, strategy_discount, network_discount, strategy_tremble, network_tremble, strategy_sym, network_sym, score_copy_prob, copy_error, explore_prob);
+        Agent A(population,i,strat_matrix,strategy_learning_speed, network_learning_speed, strategy_discount, network_discount, strategy_tremble, network_tremble, strategy_sym, network_sym, score_copy_prob, copy_error, explore_prob);
 
         // Create friend weights vector
         std::vector<double>::const_iterator first = net_matrix.begin() + (i * pop);
@@ -108,6 +106,19 @@ int Network::getPop(){
     return pop;
 }
 
+Population& Network::getPopulation(){
+    return population;
+}
+
 std::vector<Agent> Network::getAgents(){
     return agents;
 }
+
+RankModel parseRankModel(const std::string &rank_model){
+    if(rank_model == "Static"){
+        return RANK_STATIC;
+    }else if(rank_model == "Dynamic"){
+        return RANK_DYNAMIC;
+    }
+    return RANK_UNKNOWN;
+}
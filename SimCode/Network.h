@@ -0,0 +1,1824 @@
+/* The Network class Header (Network.h) */
+#include <stdio.h>
+#include <string>   // using string
+#include <vector>
+#include <bitset>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <boost/range/numeric.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+
+typedef boost::mt19937 Engine;
+typedef boost::uniform_real<double> UDistribution;
+typedef boost::normal_distribution<double> NDistribution;   // Normal Distribution
+typedef boost::variate_generator<Engine &, NDistribution > NGenerator;    // Variate generator
+
+// Buffered uniform draws
+// Uniforms are generated RNG_BUFFER_SIZE at a time and handed out one per call, so
+// the per-draw cost is a buffer read.  By default the buffer is filled from the
+// run's mt19937 with boost::uniform_real's arithmetic, giving exactly the numbers of
+// variate_generator<Engine &, UDistribution> (as long as nothing else draws from the
+// engine).  Building with -DSIMD_RNG fills it from RNG_LANES interleaved xoshiro256+
+// generators (seeded from the engine) in a loop the compiler vectorizes: faster, but
+// a different stream from the paper's.
+#ifndef RNG_BUFFER_SIZE
+    #define RNG_BUFFER_SIZE 256
+#endif
+#define RNG_LANES 8
+
+class UniformBuffer{
+    public:
+        UniformBuffer(Engine &eng, UDistribution dist) : eng(eng), min_value(dist.min()), max_value(dist.max()), pos(RNG_BUFFER_SIZE) {
+            #ifdef SIMD_RNG
+                seeded = false;
+            #endif
+        }
+
+        // Next uniform draw in [min, max)
+        double operator()(){
+            if(pos == RNG_BUFFER_SIZE){
+                refill();
+            }
+            return buffer[pos++];
+        }
+
+    private:
+        Engine &eng;
+        double min_value;
+        double max_value;
+        int pos;
+        double buffer[RNG_BUFFER_SIZE];
+        #ifdef SIMD_RNG
+            uint64_t state[4][RNG_LANES];
+            bool seeded;
+        #endif
+
+        void refill(){
+            #ifdef SIMD_RNG
+                // Lanes are seeded from the engine on first use (after the engine's own seeding)
+                if(!seeded){
+                    for(int lane = 0; lane < RNG_LANES; lane++){
+                        uint64_t x = eng();
+                        x = (x << 32) | eng();
+                        for(int w = 0; w < 4; w++){
+                            // splitmix64
+                            x += 0x9E3779B97F4A7C15ull;
+                            uint64_t z = x;
+                            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                            state[w][lane] = z ^ (z >> 31);
+                        }
+                    }
+                    seeded = true;
+                }
+                for(int block = 0; block < RNG_BUFFER_SIZE; block += RNG_LANES){
+                    // Kept rolled so GCC vectorizes across lanes instead of unrolling them
+                    #pragma GCC unroll 1
+                    for(int lane = 0; lane < RNG_LANES; lane++){
+                        uint64_t result = state[0][lane] + state[3][lane];
+                        uint64_t shifted = state[1][lane] << 17;
+                        state[2][lane] ^= state[0][lane];
+                        state[3][lane] ^= state[1][lane];
+                        state[1][lane] ^= state[2][lane];
+                        state[0][lane] ^= state[3][lane];
+                        state[2][lane] ^= shifted;
+                        state[3][lane] = (state[3][lane] << 45) | (state[3][lane] >> 19);
+                        
+                        // Top 52 bits as the mantissa of a double in [1,2)
+                        uint64_t bits = (result >> 12) | 0x3FF0000000000000ull;
+                        double unit;
+                        std::memcpy(&unit, &bits, sizeof(unit));
+                        buffer[block + lane] = (unit - 1.0) * (max_value - min_value) + min_value;
+                    }
+                }
+            #else
+                // boost::uniform_real's generate_uniform_real, one engine word per draw.  Words
+                // are drawn first and converted in a second (vectorized) loop; draws are only
+                // retried one at a time if the range lets the largest word round up to max.
+                const double divisor = (double) ((eng.max)() - (eng.min)()) + 1;
+                if((divisor - 1) / divisor * (max_value - min_value) + min_value < max_value){
+                    Engine::result_type words[RNG_BUFFER_SIZE]; // Local, so it can't alias the engine state
+                    for(int i = 0; i < RNG_BUFFER_SIZE; i++){
+                        words[i] = eng() - (eng.min)();
+                    }
+                    for(int i = 0; i < RNG_BUFFER_SIZE; i++){
+                        buffer[i] = (double) words[i] / divisor * (max_value - min_value) + min_value;
+                    }
+                }else{
+                    for(int i = 0; i < RNG_BUFFER_SIZE; i++){
+                        double result;
+                        do{
+                            double numerator = (double) (eng() - (eng.min)());
+                            result = numerator / divisor * (max_value - min_value) + min_value;
+                        }while(!(result < max_value));
+                        buffer[i] = result;
+                    }
+                }
+            #endif
+            pos = 0;
+        }
+};
+
+typedef UniformBuffer UGenerator;
+
+template<typename ... Args>
+std::string string_format(const std::string& format, Args ... args){
+    size_t size = 1 + std::snprintf(nullptr, 0, format.c_str(), args ...);
+    std::unique_ptr<char[]> buf(new char[size]);
+    snprintf(buf.get(), size, format.c_str(), args ...);
+    return std::string(buf.get(), buf.get() + size - 1); // Without the terminating null
+}
+
+// Random number generator
+struct MersenneRNG {
+    MersenneRNG() : dist(0.0, 1.0), rng(eng, dist) {}
+    
+    Engine eng;
+    UDistribution dist;
+    UGenerator rng;
+};
+
+// Counter-based random numbers (-DCOUNTER_RNG)
+// Every draw is a Philox4x32-10 hash of (seed, timestep, agent, purpose, index), so
+// any agent's draws can be made on any thread, in any order, and give the same
+// trajectory.  A run is reproducible from its seed, but the trajectory differs from
+// the default mt19937 stream.
+
+// What a stream is used for (each gets independent numbers)
+enum DrawPurpose {DRAW_SHUFFLE, DRAW_INIT_SCORE, DRAW_PARTNER, DRAW_VISIT_STRATEGY, DRAW_HOST_STRATEGY, DRAW_COUPLING};
+
+class CounterStream{
+    public:
+        CounterStream(uint32_t seed, uint32_t timestep, uint32_t agent, uint32_t purpose) : used(4) {
+            this->seed = seed;
+            ctr[0] = timestep;
+            ctr[1] = agent;
+            ctr[2] = purpose;
+            ctr[3] = 0;
+        }
+
+        // Next uniform draw in [0,1) (53 random bits, like UGenerator's range)
+        double operator()(){
+            if(used == 4){
+                philox(seed, ctr, block);
+                ctr[3]++;
+                used = 0;
+            }
+            double draw = uniform(block[used], block[used + 1]);
+            used += 2;
+            return draw;
+        }
+
+        // Philox4x32 with 10 rounds: block x of counter ctr under the seed's key
+        static inline void philox(uint32_t seed, const uint32_t ctr[4], uint32_t x[4]){
+            uint32_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+            uint32_t k0 = seed;
+            uint32_t k1 = 0x41544201; // Fixed second key word
+            for(int round = 0; round < 10; round++){
+                uint64_t product0 = (uint64_t) 0xD2511F53 * x0;
+                uint64_t product1 = (uint64_t) 0xCD9E8D57 * x2;
+                x0 = (uint32_t) (product1 >> 32) ^ x1 ^ k0;
+                x1 = (uint32_t) product1;
+                x2 = (uint32_t) (product0 >> 32) ^ x3 ^ k1;
+                x3 = (uint32_t) product0;
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+            x[0] = x0;
+            x[1] = x1;
+            x[2] = x2;
+            x[3] = x3;
+        }
+
+        // Uniform in [0,1) from two words of a block
+        static inline double uniform(uint32_t first, uint32_t second){
+            uint32_t hi = first >> 5;
+            uint32_t lo = second >> 6;
+            return (hi * 67108864.0 + lo) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        uint32_t seed;
+        uint32_t ctr[4];
+        uint32_t block[4];
+        int used;
+};
+
+// Partner samplers
+// Draw an interaction partner with probability proportional to an agent's
+// committed (cur) network weights.  Small populations scan the weight row
+// directly; large ones keep a per-agent sum tree that is patched with the
+// handful of entries that change each timestep instead of being rebuilt.
+
+// Populations at least this large use the sum tree sampler
+#ifndef SAMPLER_TREE_MIN_POP
+    #define SAMPLER_TREE_MIN_POP 128
+#endif
+
+struct Population;
+
+class PartnerSampler{
+    public:
+        virtual ~PartnerSampler(){}
+    
+        // Rebuild an agent's sampling structure from its committed weights
+        virtual void build(int agent) = 0;
+    
+        // Agent's weights were committed: all entries scaled by factor, the population's
+        // dirty entries overwritten (or the whole row, if it is marked dirty)
+        virtual void commit(int agent, double factor){}
+    
+        // Draw a partner other than the agent itself (draw is uniform on [0,1)), -1 if none.
+        // Only reads, so concurrent draws are safe
+        virtual int sample(int agent, double draw) = 0;
+};
+
+// Prefix sum and branch-free count over the weight row, O(pop) per draw
+class ScanSampler : public PartnerSampler{
+    private:
+        Population &population;
+    
+    public:
+        ScanSampler(Population &population);
+        void build(int agent);
+        int sample(int agent, double draw);
+};
+
+// Per-agent Fenwick tree over relative weights, O(log pop) per draw and per changed entry
+class TreeSampler : public PartnerSampler{
+    private:
+        Population &population;
+        int pop;
+        int top_step; // Largest power of two <= pop
+    
+        std::vector<double> tree; // Held rows x (pop + 1), 1-indexed Fenwick trees
+        std::vector<double> values; // Held rows x pop, weights relative to scale
+        std::vector<double> scale; // Committed weight = scale * relative weight
+    
+        void set(int agent, int partner, double value);
+    
+    public:
+        TreeSampler(Population &population);
+        void build(int agent);
+        void commit(int agent, double factor);
+        int sample(int agent, double draw);
+};
+
+// Cumulative weight rows built once, binary search per draw. Only valid while the
+// weights never change (no network learning).
+class FixedSampler : public PartnerSampler{
+    private:
+        Population &population;
+        int pop;
+        std::vector<double> cumulative; // Held rows x pop prefix sums of the committed rows
+    
+    public:
+        FixedSampler(Population &population);
+        void build(int agent);
+        int sample(int agent, double draw);
+};
+
+// Scan over a substrate agent's edges, O(degree) per draw
+class SubstrateSampler : public PartnerSampler{
+    private:
+        Population &population;
+    
+    public:
+        SubstrateSampler(Population &population);
+        void build(int agent);
+        int sample(int agent, double draw);
+};
+
+#ifdef SPARSE_NETWORK
+// Explicit weights, then the rest mass spread evenly over the other partners, O(k) per draw
+class SparseSampler : public PartnerSampler{
+    private:
+        Population &population;
+    
+    public:
+        SparseSampler(Population &population);
+        void build(int agent);
+        int sample(int agent, double draw);
+};
+#endif
+
+std::unique_ptr<PartnerSampler> makePartnerSampler(Population &population, bool frozen = false);
+
+// Lazy discounting
+// Discounting multiplies a per-row scale instead of every weight in the row
+// (true weight = stored weight * scale), so it is O(1) per interaction.  A row
+// is folded back to scale 1 once its scale drops below this; building with
+// -DDISCOUNT_RENORM_SCALE=1 folds on every discount, which reproduces the
+// eager per-weight arithmetic exactly.
+#ifndef DISCOUNT_RENORM_SCALE
+    #define DISCOUNT_RENORM_SCALE 1e-32
+#endif
+
+// Weight floor
+// Links and strategies that go unreinforced shrink geometrically, and in long runs
+// their weights reach the subnormal range, where every multiply and add over the row
+// takes the slow path.  With -DWEIGHT_FLOOR=f, whenever a row is folded (above) the
+// weights below f times the row's total are set to 0.  A zeroed link can then only be
+// chosen by a tremble instead of with probability below f, and is rebuilt by payoffs
+// as before once it is visited; f = 1e-30 keeps every weight normal, also with
+// FLOAT_WEIGHTS.  Off by default (results then differ from the default build only
+// when such a link would have been drawn).
+
+// Weight storage
+// Network and strategy weights are stored as weight_t.  -DFLOAT_WEIGHTS stores them
+// in single precision, halving the memory traffic of the pop x pop rows; scales,
+// payoffs, scores, row sums and the samplers' prefix sums stay double.
+#ifdef FLOAT_WEIGHTS
+    typedef float weight_t;
+#else
+    typedef double weight_t;
+#endif
+
+// Sparse network
+// With -DSPARSE_NETWORK=k an agent keeps explicit weights for at most k partners and
+// one "rest" mass shared evenly by all its other partners, instead of a dense row of
+// pop weights, so memory and per-step cost are O(pop k) rather than O(pop^2).  A payoff
+// from an implicit partner promotes it, taking its even share of the rest mass plus the
+// payoff; when the row is full, the smallest explicit weight first goes back into the
+// rest mass.  Discounting scales both parts.  With k >= pop - 1 nothing is ever evicted
+// and the dynamics are the dense ones (up to rounding).  Weights output changes format,
+// see the README.
+#ifdef SPARSE_NETWORK
+struct SparseRow{
+    int count; // Explicit partners
+    weight_t rest; // Total weight of the pop - 1 - count implicit partners
+    int partner[SPARSE_NETWORK]; // Ascending
+    weight_t weight[SPARSE_NETWORK];
+    
+    // The index-th partner (ascending) that is neither self nor explicit
+    int implicitPartner(int self, int index) const;
+};
+#endif
+
+// Sparse commit
+// Entries of new_weights written during a step are remembered per agent so the
+// end-of-step commit only copies those into cur_weights.  Rows with more writes
+// than this (or rescaled as a whole) are copied in full.
+#ifndef COMMIT_DIRTY_CAP
+    #define COMMIT_DIRTY_CAP 16
+#endif
+
+// Tremble skip-ahead
+// With -DTREMBLE_SKIP an agent does not draw a uniform per decision to test for a
+// tremble.  It keeps, per decision kind (partner, and strategy per role), the
+// geometric number of decisions until its next tremble and counts it down, drawing
+// only when a tremble happens.  The tremble process is the same Bernoulli sequence,
+// but the numbers drawn (and so trajectories) differ from the default build.
+#if defined(TREMBLE_SKIP) && defined(COUNTER_RNG)
+    #error "TREMBLE_SKIP keeps per-agent countdowns across draws, which COUNTER_RNG's independent streams do not allow"
+#endif
+
+// Bonus cache
+// Per-agent coupling transform of the committed score (Coupling::scoreKey, e.g.
+// -log(1.001-score) for FightSplit or score^6 for FightRand), so transcendental
+// math runs when a score is committed rather than in every interaction.
+struct BonusCache{
+    double (*transform)(double score);
+    std::vector<double> score_key; // pop
+    
+    void init(int pop){
+        transform = identity;
+        score_key.assign(pop, 0.0);
+    }
+    
+    // Switch transform and recompute every agent from its committed score
+    void setTransform(double (*transform)(double), const std::vector<double> &cur_score){
+        this->transform = transform;
+        for(size_t i = 0; i < score_key.size(); i++){
+            score_key[i] = transform(cur_score[i]);
+        }
+    }
+    
+    void refresh(int agent, double score){
+        score_key[agent] = transform(score);
+    }
+    
+    static double identity(double score){ return score; }
+};
+
+// Interaction substrate
+// By default every agent can visit every other (the complete graph).  A substrate
+// graph, from the conf file's optional Substrate column, fixes which partners each
+// agent can ever visit: network weights are kept only on its edges, and both weighted
+// and trembling partner choices are among the agent's neighbours, so per-step cost
+// scales with the mean degree rather than pop.  Edges are undirected, so the host
+// always has the link back for symmetric network learning.
+struct Substrate{
+    std::vector<size_t> offsets; // pop + 1, empty for the complete graph
+    std::vector<int> neighbors; // Agent i's are [offsets[i], offsets[i+1]), ascending
+    
+    bool complete() const { return offsets.empty(); }
+    int degree(int agent) const { return (int) (offsets[agent + 1] - offsets[agent]); }
+};
+
+// Build the substrate named by spec (Complete, Ring:k, Lattice[:width], ER:mean_degree,
+// SmallWorld:k:rewire_prob or Edges:file, the file relative to input_folder); random
+// graphs are drawn from rng.  Exits with an error for a bad spec or an isolated agent.
+Substrate makeSubstrate(const std::string &spec, int pop, const std::string &input_folder, UGenerator &rng);
+
+// Distributed runs
+// With -DUSE_MPI (built with mpicxx, and only together with COUNTER_RNG) one
+// simulation is split over the processes of an MPI job.  Process r holds the network
+// rows of agents [firstRow(pop, r), firstRow(pop, r + 1)), draws those agents' visits
+// and applies their updates; strategies and scores are small and are copied to every
+// process after each commit, so any process can draw a host's strategy.  Each step the
+// host side of every interaction is sent to the process holding the host.  Trackers
+// are reduced or gathered on process 0, which writes the output.  The counter streams
+// make the trajectory the same as a single process's, whatever the process count.
+#if defined(USE_MPI) && !defined(COUNTER_RNG)
+    #error "USE_MPI draws each agent on the process that holds it, which needs COUNTER_RNG's per-agent streams"
+#endif
+
+#ifdef USE_MPI
+void startProcesses(int *argc, char ***argv);
+void stopProcesses();
+int processRank();
+int processCount();
+int firstRow(int pop, int rank);
+int rowOwner(int pop, int agent);
+bool broadcastFlag(bool flag); // Process 0's value, on every process
+#endif
+
+// Population store
+// Learning state for the whole population is kept in flat, contiguous arrays
+// (one allocation per quantity instead of several per agent) so the timestep
+// loop and the trackers walk memory linearly.  Agent is a view onto one row.
+struct Population{
+    int pop;
+    int num_roles; // Strategy sets per agent (visitor, host)
+    int num_strats; // Strategies per set
+    int num_interactions; // Interaction types (num_strats x num_strats)
+    
+    // Partners each agent can visit
+    Substrate substrate;
+    
+    // Agents whose network rows are held here, [row_begin, row_end): everyone, except
+    // in a distributed run
+    int row_begin;
+    int row_end;
+    
+    // Network weights, pop x pop row-major (row = agent, column = partner), or with a
+    // substrate one entry per edge (row = agent, column = position among its neighbors).
+    // Only the held rows are stored
+    std::vector<weight_t> cur_weights;
+    std::vector<weight_t> new_weights;
+    
+#ifdef SPARSE_NETWORK
+    // Network weights as sparse rows, one per held agent (the dense arrays above stay empty)
+    std::vector<SparseRow> cur_rows;
+    std::vector<SparseRow> new_rows;
+#endif
+    
+    // Strategy weights, pop x num_roles x num_strats
+    std::vector<weight_t> cur_strats;
+    std::vector<weight_t> new_strats;
+    
+    // Scores (rank)
+    std::vector<double> cur_score;
+    std::vector<double> new_score;
+    
+    // Cumulative payoffs (static ranks, dynamic ranks accumulate into new_score)
+    std::vector<double> total_payoff;
+    
+    // Lazy discount scales, true weight = stored weight * scale
+    std::vector<double> cur_weight_scale; // pop
+    std::vector<double> new_weight_scale;
+    std::vector<double> cur_strat_scale; // pop x num_roles
+    std::vector<double> new_strat_scale;
+    
+    // Entries of new_weights written since the last commit, pop x COMMIT_DIRTY_CAP
+    std::vector<int> dirty;
+    std::vector<int> dirty_count; // Above COMMIT_DIRTY_CAP the whole row is committed
+    
+    // Interaction counts, pop x num_interactions
+    std::vector<int> interactions;
+    
+    // Decisions left before the next tremble (TREMBLE_SKIP), pop x (1 + num_roles): the
+    // partner choice, then one strategy choice per role. -1 until first drawn
+    std::vector<int> tremble_gap;
+    
+    // Coupling transform of cur_score
+    BonusCache bonus_cache;
+    
+    // Partner sampler over cur_weights
+    std::unique_ptr<PartnerSampler> sampler;
+    
+    void init(int pop, const std::vector<int> &num_strats, const Substrate &substrate = Substrate()){
+        this->pop = pop;
+        this->substrate = substrate;
+        num_roles = (int) num_strats.size();
+        this->num_strats = num_strats.at(0);
+        num_interactions = this->num_strats * this->num_strats;
+        
+#ifdef USE_MPI
+        row_begin = firstRow(pop, processRank());
+        row_end = firstRow(pop, processRank() + 1);
+#else
+        row_begin = 0;
+        row_end = pop;
+#endif
+        
+#ifdef SPARSE_NETWORK
+        if(!substrate.complete()){
+            std::cerr << "Error: substrate graphs store one weight per edge already, build without SPARSE_NETWORK to use them\n";
+            _Exit(1);
+        }
+        SparseRow empty_row = SparseRow();
+        cur_rows.assign(row_end - row_begin, empty_row);
+        new_rows.assign(row_end - row_begin, empty_row);
+#else
+        size_t num_weights = substrate.complete() ? (size_t) (row_end - row_begin) * pop : substrate.offsets[row_end] - substrate.offsets[row_begin];
+        cur_weights.assign(num_weights, 0.0);
+        new_weights.assign(num_weights, 0.0);
+#endif
+        cur_strats.assign((size_t) pop * num_roles * this->num_strats, 0.0);
+        new_strats.assign((size_t) pop * num_roles * this->num_strats, 0.0);
+        cur_score.assign(pop, 0.0);
+        new_score.assign(pop, 0.0);
+        total_payoff.assign(pop, 0.0);
+        cur_weight_scale.assign(pop, 1.0);
+        new_weight_scale.assign(pop, 1.0);
+        cur_strat_scale.assign((size_t) pop * num_roles, 1.0);
+        new_strat_scale.assign((size_t) pop * num_roles, 1.0);
+        dirty.assign((size_t) pop * COMMIT_DIRTY_CAP, 0);
+        dirty_count.assign(pop, COMMIT_DIRTY_CAP + 1);
+        interactions.assign((size_t) pop * num_interactions, 0);
+        tremble_gap.assign((size_t) pop * (1 + num_roles), -1);
+        bonus_cache.init(pop);
+        
+        sampler = makePartnerSampler(*this);
+    }
+    
+    bool holdsRow(int agent) const { return agent >= row_begin && agent < row_end; }
+    
+    // Weight rows (held agents only): column j of agent's row is the link to partnerAt(agent, j)
+    size_t rowStart(int agent) const { return substrate.complete() ? (size_t) (agent - row_begin) * pop : substrate.offsets[agent] - substrate.offsets[row_begin]; }
+    int rowLength(int agent) const { return substrate.complete() ? pop : substrate.degree(agent); }
+    int partnerAt(int agent, int column) const { return substrate.complete() ? column : substrate.neighbors[substrate.offsets[agent] + column]; }
+    int columnOf(int agent, int partner) const {
+        if(substrate.complete()){
+            return partner;
+        }
+        const int *first = &substrate.neighbors[substrate.offsets[agent]];
+        return (int) (std::lower_bound(first, first + substrate.degree(agent), partner) - first);
+    }
+    
+    weight_t* curFriends(int agent){ return &cur_weights[rowStart(agent)]; }
+    weight_t* newFriends(int agent){ return &new_weights[rowStart(agent)]; }
+#ifdef SPARSE_NETWORK
+    SparseRow& curRow(int agent){ return cur_rows[agent - row_begin]; }
+    SparseRow& newRow(int agent){ return new_rows[agent - row_begin]; }
+#endif
+    weight_t* curStrats(int agent, int role){ return &cur_strats[((size_t) agent * num_roles + role) * num_strats]; }
+    weight_t* newStrats(int agent, int role){ return &new_strats[((size_t) agent * num_roles + role) * num_strats]; }
+    int* agentInteractions(int agent){ return &interactions[(size_t) agent * num_interactions]; }
+    int* agentDirty(int agent){ return &dirty[(size_t) agent * COMMIT_DIRTY_CAP]; }
+    int* agentTrembleGaps(int agent){ return &tremble_gap[(size_t) agent * (1 + num_roles)]; }
+    
+    void markDirty(int agent, int partner){
+        int &count = dirty_count[agent];
+        if(count < COMMIT_DIRTY_CAP){
+            dirty[(size_t) agent * COMMIT_DIRTY_CAP + count] = partner;
+        }
+        count++;
+    }
+    void markRowDirty(int agent){ dirty_count[agent] = COMMIT_DIRTY_CAP + 1; }
+    bool rowDirty(int agent){ return dirty_count[agent] > COMMIT_DIRTY_CAP; }
+    
+    // Weights will not change again: switch to the fixed-distribution sampler
+    void freezeNetwork(){
+        sampler = makePartnerSampler(*this, true);
+        for(int i = row_begin; i < row_end; i++){
+            sampler->build(i);
+        }
+    }
+};
+
+//Agent Class
+
+class Agent{
+    private:
+    
+        // Population store holding this agent's weights, strategies and scores
+        Population *population;
+    
+        // Innovation space location
+        int cur_location_int;
+        int new_location_int;
+        std::bitset<20> cur_location_bin;
+        std::bitset<20> new_location_bin;
+        
+        // Perceived score
+        double perceived_cur_score;
+        double perceived_new_score;
+        
+        // Agent id
+        int agent_id;
+    
+        // Factor applied to all stored new_friends weights since the last commit (renormalization)
+        double network_scale_pending;
+    
+        // Track last interaction
+        double past_p1_payoff;
+        double past_p2_payoff;
+    
+        // Last strategy played
+        int currentStrategy;
+        // Last payoff earned
+        double currentPayoff;
+        // Last friend visited
+        int currentFriend;
+        int last_visit;
+    
+        // Learning Speeds
+        float strategy_learning_speed;
+        float network_learning_speed;
+        
+        // Past Discounting (Memory)
+        float strategy_discount;
+        float network_discount;
+        
+        // Tremble (Error rate)
+        float strategy_tremble;
+        float network_tremble;
+        
+        // Symmetry (For strategy: Are strategies in different contexts (home/away) correlated, for network: are directed network links (in/out) correlated).
+        bool strategy_sym;
+        bool network_sym;
+        
+        // Innovation variables
+        float score_copy_prob; // Probability of copying neighbor
+        float copy_error; // Error in copying different bits
+        float explore_prob; // Probability of exploring
+    
+        int rounds_since_copy;
+    public:
+        Agent(Population &population, const int agent_id, double fill_value = 1, float strategy_learning_speed = 1, float network_learning_speed = 1, float strategy_discount = 0.01, float network_discount = 0.01, float strategy_tremble = 0.01, float network_tremble = 0.01, bool strategy_sym = 0, bool network_sym = 0, float score_copy_prob = 0.1, float copy_error = 0.1, float explore_prob = 1);
+        Agent(Population &population, const int agent_id, const std::vector<double> &fill_values, float strategy_learning_speed = 1, float network_learning_speed = 1, float strategy_discount = 0.01, float network_discount = 0.01, float strategy_tremble = 0.01, float network_tremble = 0.01, bool strategy_sym = 0, bool network_sym = 0, float score_copy_prob = 0.1, float copy_error = 0.1, float explore_prob = 1);
+        
+        // Get Agent ID (shouldn't be necessary)
+        int getID();
+        
+        // Get Agent strategy profile for given strategy set (defined by strat_num)
+        std::vector<double> getStrats(int strat_num);
+        void setStrats(int strat_num, const std::vector<double> &strats); // True weights, committed by updateAgent
+        void discountStrategy(int strat_num);
+        void discountNeighbors();
+        void scaleStrategy(int strat_num, double factor); // Several discounts at once (factor is their product)
+        void scaleNeighbors(double factor);
+    
+        std::vector<int> getInteractions();
+        
+        // Set Agent friends from network
+        void setFriends(std::vector<double> friends);
+        void setUniformFriends(double fill_value); // fill_value for every partner, 0 for self
+        std::vector<double> getFriends() const;
+        
+        void updateAgent();
+    
+        // Draws take a UGenerator or a CounterStream
+        template<class Gen>
+        int chooseFriend(Gen &rng, const std::vector<int> &agent_seq, int seq_pos);
+        template<class Gen>
+        int chooseFixedFriend(Gen &rng, const std::vector<int> &agent_seq, int seq_pos); // Same draws, no network discounting
+        int getCurrentFriend();
+        void setCurrentFriend(int friend_id);
+    
+        template<class Gen>
+        void chooseStrategy(Gen &rng, int strategy_role);
+        template<class Gen>
+        int drawStrategy(Gen &rng, int strategy_role); // Same draws, current strategy left unset (still counts down TREMBLE_SKIP)
+    
+        // Whether this decision (0 partner, 1 + role strategy) is a tremble, by TREMBLE_SKIP
+        // countdown: each call uses up one decision of the agent's countdown
+        template<class Gen>
+        bool nextTremble(Gen &rng, int decision, double tremble);
+        int getCurrentStrategy();
+        void setCurrentStrategy(int strategy);
+    
+        void setCurrentPayoff(double currentPayoff);
+        double getCurrentPayoff();
+
+        void trackPayoffs(double last_payoff);
+    
+        template<class Rank>
+        void addStrategyPayoff(int strategy_role);
+    
+        void addNetworkPayoff();
+    
+        // Add amount (in true weight) to one strategy or one partner's link
+        void addStrategyWeight(int strategy_role, int strategy, double amount);
+        void addNetworkWeight(int partner, double amount);
+    
+        int convertBin2Dec(std::bitset<20> bin);
+    
+        int getLocationInt();
+        std::bitset<20> getLocationBin();
+    
+
+        double getScore();
+        double getScoreKey();
+    
+        template<class Gen>
+        void setInitScore(Gen &rng);
+    
+        void updateInteractions(int inter_number);
+    
+        void recordInteraction(double visitPayoff, double hostPayoff);
+        
+        double getPastVisitPayoff();
+        double getPastHostPayoff();
+        int getPastVisitPartner();
+    
+        void setStrategyLearning(float strategy_learning_speed);
+        float getStrategyLearning();
+        
+        void setNetworkLearning(float network_learning_speed);
+        float getNetworkLearning();
+        
+        void setStrategyDiscount(float strategy_discount);
+        float getStrategyDiscount();
+        
+        void setNetworkDiscount(float network_discount);
+        float getNetworkDiscount();
+        
+        void setStrategyTremble(float strategy_tremble);
+        float getStrategyTremble();
+        
+        void setNetworkTremble(float network_tremble);
+        float getNetworkTremble();
+        
+        void setStrategySym(bool strategy_sym);
+        bool getStrategySym();
+        
+        void setNetworkSym(bool network_sym);
+        bool getNetworkSym();
+        
+        void setScoreCopyProb(float score_copy_prob);
+        float getScoreCopyProb();
+        
+        void setCopyError(float copy_error);
+        float getCopyError();
+        
+        void setExploreProb(float explore_prob);
+        float getExploreProb();
+};
+
+//Network Class
+class Network{
+    private:
+        // Population of network
+        int pop;
+        
+        // Flat learning state for all agents
+        Population population;
+    
+        // Vector of Agents (views onto population)
+        std::vector<Agent> agents;
+    
+    public:
+        Network(int pop = 20, const std::vector<int> &num_strats = {2,2}, float strategy_learning_speed = 1, float network_learning_speed = 1, float strategy_discount = 0.01, float network_discount = 0.01, float strategy_tremble = 0.01, float network_tremble = 0.01, bool strategy_sym = 0, bool network_sym = 0, float score_copy_prob = 0.1, float copy_error = 0.1, float explore_prob = 1);
+        Network(int pop, std::string strat_filepath, const std::vector<int> &num_strats, float strategy_learning_speed = 1, float network_learning_speed = 1, float strategy_discount = 0.01, float network_discount = 0.01, float strategy_tremble = 0.01, float network_tremble = 0.01, bool strategy_sym = 0, bool network_sym = 0, float score_copy_prob = 0.1, float copy_error = 0.1, float explore_prob = 1, const Substrate &substrate = Substrate());
+        Network(std::string net_filepath, std::string strat_filepath, const std::vector<int> &num_strats, float strategy_learning_speed = 1, float network_learning_speed = 1, float strategy_discount = 0.01, float network_discount = 0.01, float strategy_tremble = 0.01, float network_tremble = 0.01, bool strategy_sym = 0, bool network_sym = 0, float score_copy_prob = 0.1, float copy_error = 0.1, float explore_prob = 1);
+    
+        // Agents point into population, so a Network cannot be copied
+        Network(const Network&) = delete;
+        Network& operator=(const Network&) = delete;
+    
+        std::vector<int> agent_seq;
+    
+        int getPop();
+        Population& getPopulation();
+        std::vector<Agent> getAgents();
+    
+        Agent& GetAgent(std::vector<Agent>::size_type ElementNumber);
+        void AddAgent(const Agent& NewAgent);
+
+};
+
+// Rank models
+// How scores (ranks) evolve over a run, chosen per row by the RankModel column.
+// Each model is a policy type so both share one timestep kernel.
+// Static: scores are drawn once and never change, payoffs accumulate in total_payoff.
+// Dynamic: scores start at 0 and accumulate strategy payoffs, so the coupling
+// transforms in the BonusCache are refreshed whenever scores are committed.
+// payoffs and commitScore take any store with Population's score members.
+enum RankModel {RANK_STATIC, RANK_DYNAMIC, RANK_UNKNOWN};
+
+RankModel parseRankModel(const std::string &rank_model);
+
+struct StaticRank{
+    static const bool random_init = true; // Scores drawn at the start of the run
+    static const bool discount_idle_role = false; // Only the played roles' strategies are discounted
+    static const bool track_ranks = false; // No every-10-step NetSTD/OutFS/OutScore trackers
+    
+    template<class Store>
+    static double* payoffs(Store &population){
+        return population.total_payoff.data();
+    }
+    static const std::vector<double>& totalPayoffs(Population &population){
+        return population.total_payoff;
+    }
+    template<class Store>
+    static void commitScore(Store &population, int agent){
+        // Scores are fixed, the cached transforms stay valid
+    }
+};
+
+struct DynamicRank{
+    static const bool random_init = false;
+    static const bool discount_idle_role = true; // Both roles are discounted at every interaction
+    static const bool track_ranks = true;
+    
+    template<class Store>
+    static double* payoffs(Store &population){
+        return population.new_score.data();
+    }
+    static const std::vector<double>& totalPayoffs(Population &population){
+        return population.cur_score;
+    }
+    template<class Store>
+    static void commitScore(Store &population, int agent){
+        population.bonus_cache.refresh(agent, population.cur_score[agent]);
+    }
+};
+
+// Coupling functions
+// Rank-dependent bonus added to the base payoffs of a (visitor, host) interaction.
+// Each coupling_effect is a policy type so the interaction kernel is compiled for
+// one coupling, chosen once per run, instead of comparing strings per interaction.
+// fight_bonus is the bonus row of the payoff file: {winner bonus, tie bonus}.
+// scoreKey is the per-score transform the bonus needs (kept in the BonusCache),
+// visitKey/hostKey are scoreKey of visitScore/hostScore.
+// Couplings with uses_draw get one uniform draw per interaction, taken by the
+// caller right after the strategy draws.
+// Fight bonuses go to interactions where both play strategy 0 (Hawk), hunt bonuses
+// where both play strategy 1 (Stag); in games of more strategies the others get none.
+enum CouplingType {COUPLING_FIGHT, COUPLING_FIGHTSPLIT, COUPLING_FIGHTRAND, COUPLING_STAGHUNT, COUPLING_FSH, COUPLING_NONE, COUPLING_UNKNOWN};
+
+CouplingType parseCoupling(const std::string &coupling_effect);
+
+struct FightCoupling{
+    static const bool uses_draw = false;
+    
+    static double scoreKey(double score){
+        return score;
+    }
+    
+    static std::array<double,2> bonus(const double *fight_bonus, double draw, int currentAgentStrategy, int friendAgentStrategy, double visitScore, double hostScore, double visitKey, double hostKey){
+        double visit_advantage;
+        double host_advantage;
+        
+        if(visitScore > hostScore){
+            visit_advantage = fight_bonus[0];
+            host_advantage = 0;
+        }
+        else if(hostScore > visitScore){
+            visit_advantage = 0;
+            host_advantage = fight_bonus[0];
+        }else{
+            visit_advantage = fight_bonus[1];
+            host_advantage = fight_bonus[1];
+        }
+        
+        return {{visit_advantage * (bool) (friendAgentStrategy + currentAgentStrategy == 0),host_advantage * (bool) (currentAgentStrategy + friendAgentStrategy == 0)}};
+    }
+};
+
+struct FightSplitCoupling{
+    static const bool uses_draw = false;
+    
+    static double scoreKey(double score){
+        return -log(1.001-score);
+    }
+    
+    static std::array<double,2> bonus(const double *fight_bonus, double draw, int currentAgentStrategy, int friendAgentStrategy, double visitScore, double hostScore, double visitKey, double hostKey){
+        double visit_prop;
+        double host_prop;
+        double visit_advantage;
+        double host_advantage;
+        
+        if(visitScore > hostScore){
+            visit_prop = visitKey/(visitKey + hostKey);
+            host_prop = 1 - visit_prop;
+            
+            visit_advantage = visit_prop * fight_bonus[0];
+            host_advantage = host_prop * fight_bonus[0];
+        }
+        else if(hostScore > visitScore){
+            host_prop = hostKey/(visitKey + hostKey);
+            visit_prop = 1 - host_prop;
+            
+            host_advantage = host_prop * fight_bonus[0];
+            visit_advantage = visit_prop * fight_bonus[0];
+        }else{
+            visit_advantage = fight_bonus[1];
+            host_advantage = fight_bonus[1];
+        }
+        
+        return {{visit_advantage * (bool) (friendAgentStrategy + currentAgentStrategy == 0),host_advantage * (bool) (currentAgentStrategy + friendAgentStrategy == 0)}};
+    }
+};
+
+// Winner drawn with probability proportional to score^6 (one rng draw per interaction)
+struct FightRandCoupling{
+    static const bool uses_draw = true;
+    
+    static double scoreKey(double score){
+        int prob_power = 6;
+        return pow(score,prob_power);
+    }
+    
+    static std::array<double,2> bonus(const double *fight_bonus, double draw, int currentAgentStrategy, int friendAgentStrategy, double visitScore, double hostScore, double visitKey, double hostKey){
+        double visit_advantage;
+        double host_advantage;
+        
+        double denom_total = visitKey + hostKey;
+        double visit_prob = visitKey/denom_total;
+        
+        if(draw < visit_prob){
+            visit_advantage = fight_bonus[0];
+            host_advantage = 0;
+        }
+        else{
+            visit_advantage = 0;
+            host_advantage = fight_bonus[0];
+        }
+        return {{visit_advantage * (bool) (friendAgentStrategy + currentAgentStrategy == 0),host_advantage * (bool) (currentAgentStrategy + friendAgentStrategy == 0)}};
+    }
+};
+
+struct StagHuntCoupling{
+    static const bool uses_draw = false;
+    
+    static double scoreKey(double score){
+        return score;
+    }
+    
+    static std::array<double,2> bonus(const double *fight_bonus, double draw, int currentAgentStrategy, int friendAgentStrategy, double visitScore, double hostScore, double visitKey, double hostKey){
+        double score_diff = visitScore - hostScore;
+        double score_total = (visitScore + hostScore)/2;
+        
+        return {{(-0.6 + score_total - score_diff * (bool) (score_diff > 0)) * (bool) ((friendAgentStrategy == 1) & (currentAgentStrategy == 1)), (-0.6 + score_total + score_diff * (bool) (score_diff < 0)) * (bool) ((friendAgentStrategy == 1) & (currentAgentStrategy == 1))}};
+    }
+};
+
+struct FSHCoupling{
+    static const bool uses_draw = false;
+    
+    static double scoreKey(double score){
+        return score;
+    }
+    
+    static std::array<double,2> bonus(const double *fight_bonus, double draw, int currentAgentStrategy, int friendAgentStrategy, double visitScore, double hostScore, double visitKey, double hostKey){
+        double score_diff = visitScore - hostScore;
+        double score_total = (visitScore + hostScore)/2;
+        
+        return {{((0.25 + score_diff) * (bool) (friendAgentStrategy + currentAgentStrategy == 0)) + (-0.6 + score_total - score_diff * (bool) (score_diff > 0)) * (bool) ((friendAgentStrategy == 1) & (currentAgentStrategy == 1)), ((0.25 - score_diff) * (bool) (currentAgentStrategy + friendAgentStrategy == 0)) + (-0.6 + score_total + score_diff * (bool) (score_diff < 0)) * (bool) ((friendAgentStrategy == 1) & (currentAgentStrategy == 1))}};
+    }
+};
+
+struct NoCoupling{
+    static const bool uses_draw = false;
+    
+    static double scoreKey(double score){
+        return score;
+    }
+    
+    static std::array<double,2> bonus(const double *fight_bonus, double draw, int currentAgentStrategy, int friendAgentStrategy, double visitScore, double hostScore, double visitKey, double hostKey){
+        return {{0.0,0.0}};
+    }
+};
+
+// One timestep's interactions as arrays, indexed by position in the shuffled order.
+// The batched timestep draws every partner and strategy into it, evaluates all
+// payoffs in one pass (Game::playBatch) and then applies the learning updates.
+struct InteractionBatch{
+    int size;
+    int num_strats; // Interaction i is type num_strats * visit_strategy[i] + host_strategy[i]
+    
+    std::vector<int> host;
+    std::vector<int> visit_strategy;
+    std::vector<int> host_strategy;
+    
+    // Committed scores and their coupling transforms, gathered at draw time
+    std::vector<double> visit_score;
+    std::vector<double> host_score;
+    std::vector<double> visit_key;
+    std::vector<double> host_key;
+    std::vector<double> draw; // Coupling draw (uses_draw couplings only)
+    
+    std::vector<double> visit_payoff;
+    std::vector<double> host_payoff;
+    
+    // Interactions grouped by agent, each group in shuffled order. Agent a's entries are
+    // events[event_start[a]] to events[event_start[a+1]-1], encoded 2 * interaction + role.
+    std::vector<int> event_start;
+    std::vector<int> events;
+    std::vector<int> event_fill;
+    
+    void init(int size, int num_strats){
+        this->size = size;
+        this->num_strats = num_strats;
+        host.assign(size, 0);
+        visit_strategy.assign(size, 0);
+        host_strategy.assign(size, 0);
+        visit_score.assign(size, 0.0);
+        host_score.assign(size, 0.0);
+        visit_key.assign(size, 0.0);
+        host_key.assign(size, 0.0);
+        draw.assign(size, 0.0);
+        visit_payoff.assign(size, 0.0);
+        host_payoff.assign(size, 0.0);
+        event_start.assign(size + 1, 0);
+        events.assign(2 * size, 0);
+        event_fill.assign(size, 0);
+    }
+    
+    // Counting sort of the interactions by participant (visitor[i] visits host[i])
+    void indexEvents(const std::vector<int> &visitor){
+        std::fill(event_start.begin(), event_start.end(), 0);
+        for(int i = 0; i < size; i++){
+            event_start[visitor[i] + 1]++;
+            event_start[host[i] + 1]++;
+        }
+        for(int a = 0; a < size; a++){
+            event_start[a + 1] += event_start[a];
+        }
+        std::copy(event_start.begin(), event_start.end() - 1, event_fill.begin());
+        for(int i = 0; i < size; i++){
+            events[event_fill[visitor[i]]++] = 2 * i;
+            events[event_fill[host[i]]++] = 2 * i + 1;
+        }
+    }
+};
+
+#ifdef USE_MPI
+// Copy each process's committed strategies, scores and score keys to every process
+void syncCommitted(Population &population);
+
+// Send the host side of the held visitors' interactions to the processes holding the
+// hosts, and take in the ones sent here.  Afterwards an interaction whose visitor is
+// held elsewhere has its visitor as host, unless its host is held here.
+void exchangeHostEvents(Population &population, InteractionBatch &batch, const std::vector<int> &agent_seq);
+
+// Each process's values, concatenated in process order, on process 0 (or on all)
+void gatherRows(std::vector<double> &values, bool to_all = false);
+void gatherRows(std::vector<int> &values, bool to_all = false);
+
+// Element-wise sum over the processes, on process 0
+void sumToRoot(double *values, int count);
+#endif
+
+class Game{
+    private:
+        std::string gameName;
+        double base_payoff;
+        std::vector<std::vector<double>> gamePayoffs;
+        std::string coupling_effect;
+        std::vector<double> fight_bonus;
+        std::vector<int> num_strats; // Strategies per role, from the payoff file
+        
+        CouplingType coupling_type;
+        int strategies; // Strategies per role (k)
+        std::vector<double> payoff_table[2]; // gamePayoffs, [visitor/host][k * visitStrategy + hostStrategy]
+    
+        void setTables();
+        
+        // playBatch's loop, with the selects of a 2x2 game (TwoStrategies) or indexed loads
+        template<class Coupling, bool TwoStrategies>
+        void playBatchLoop(InteractionBatch &batch, int begin, int end);
+        
+    public:
+        Game(std::vector<std::vector<double>> gamePayoffs = {{0,1,0.2,0.6},{0,0.2,1,0.6}}, std::string gameName = "HDInnov", double base_payoff = 0.0001, std::vector<int> num_strats = {2,2}, std::string coupling_effect = "Fight", std::vector<double> fight_bonus = {0,0});
+            
+        Game(std::string payoff_filepath, std::string gameName = "HDInnov", double base_payoff = 0.0001, std::string coupling_effect = "Fight");
+    
+        std::string getName();
+        std::string getCouplingEffect();
+        CouplingType getCouplingType();
+        void setPayoffs(std::vector<std::vector<double>> gamePayoffs);
+        const std::vector<std::vector<double>>& getPayoffs();
+        double getBasePayoff();
+        const std::vector<int>& getNumStrats();
+    
+        // Interaction with the coupling chosen at runtime (dispatches to play)
+        std::array<double,2> playGame(UGenerator &rng, Agent &visitor, Agent &host);
+    
+        // Interaction kernel for one coupling policy
+        template<class Coupling, class Gen>
+        std::array<double,2> play(Gen &rng, Agent &visitor, Agent &host){
+            std::array<double,2> these_payoffs;
+            
+            double visitScore = visitor.getScore();
+            double hostScore = host.getScore();
+            
+            int visitStrategy = visitor.getCurrentStrategy();
+            int hostStrategy = host.getCurrentStrategy();
+            
+            int interaction_number = strategies * visitStrategy + hostStrategy;
+            
+            visitor.updateInteractions(interaction_number);
+            host.updateInteractions(interaction_number);
+            
+            double draw = Coupling::uses_draw ? rng() : 0;
+            std::array<double,2> bonus_vec = Coupling::bonus(fight_bonus.data(), draw, visitStrategy, hostStrategy, visitScore, hostScore, visitor.getScoreKey(), host.getScoreKey());
+            
+            double visitPayoff = payoff_table[0][interaction_number] + base_payoff + bonus_vec[0];
+            double hostPayoff = payoff_table[1][interaction_number] + base_payoff + bonus_vec[1];
+            
+            if(visitPayoff < base_payoff){
+                visitPayoff = base_payoff;
+            }
+            if(hostPayoff < base_payoff){
+                hostPayoff = base_payoff;
+            }
+            
+            these_payoffs[0] = visitPayoff;
+            these_payoffs[1] = hostPayoff;
+            
+            visitor.setCurrentPayoff(visitPayoff);
+            host.setCurrentPayoff(hostPayoff);
+            
+            visitor.recordInteraction(visitPayoff,hostPayoff);
+            
+            return these_payoffs;
+        }
+    
+        // Payoffs of interactions [begin, end) of the batch, same arithmetic as play.
+        // Reads and writes only the batch arrays, so the loop has no calls or
+        // agent lookups left in it.
+        template<class Coupling>
+        void playBatch(InteractionBatch &batch, int begin, int end){
+            if(strategies == 2){
+                playBatchLoop<Coupling, true>(batch, begin, end);
+            }else{
+                playBatchLoop<Coupling, false>(batch, begin, end);
+            }
+        }
+};
+
+template<class Coupling, bool TwoStrategies>
+void Game::playBatchLoop(InteractionBatch &batch, int begin, int end){
+    const int *visit_strategy = batch.visit_strategy.data();
+    const int *host_strategy = batch.host_strategy.data();
+    const double *visit_score = batch.visit_score.data();
+    const double *host_score = batch.host_score.data();
+    const double *visit_key = batch.visit_key.data();
+    const double *host_key = batch.host_key.data();
+    const double *draw = batch.draw.data();
+    double *visit_payoff = batch.visit_payoff.data();
+    double *host_payoff = batch.host_payoff.data();
+    
+    // Local copies, so the stores to the payoff arrays cannot alias them
+    const double base = base_payoff;
+    const double bonus_row[2] = {fight_bonus[0], fight_bonus[1]};
+    const int k = TwoStrategies ? 2 : strategies;
+    double table[2][4];
+    if(TwoStrategies){
+        std::copy(payoff_table[0].begin(), payoff_table[0].end(), table[0]);
+        std::copy(payoff_table[1].begin(), payoff_table[1].end(), table[1]);
+    }
+    const double *visit_table = payoff_table[0].data();
+    const double *host_table = payoff_table[1].data();
+    
+    for(int i = begin; i < end; i++){
+        int interaction_number = k * visit_strategy[i] + host_strategy[i];
+        
+        std::array<double,2> bonus_vec = Coupling::bonus(bonus_row, draw[i], visit_strategy[i], host_strategy[i], visit_score[i], host_score[i], visit_key[i], host_key[i]);
+        
+        double visitBase;
+        double hostBase;
+        if(TwoStrategies){
+            // Selects instead of an indexed load, which plain SSE2 cannot vectorize
+            visitBase = interaction_number == 0 ? table[0][0] : interaction_number == 1 ? table[0][1] : interaction_number == 2 ? table[0][2] : table[0][3];
+            hostBase = interaction_number == 0 ? table[1][0] : interaction_number == 1 ? table[1][1] : interaction_number == 2 ? table[1][2] : table[1][3];
+        }else{
+            visitBase = visit_table[interaction_number];
+            hostBase = host_table[interaction_number];
+        }
+        
+        double visitPayoff = visitBase + base + bonus_vec[0];
+        double hostPayoff = hostBase + base + bonus_vec[1];
+        
+        visit_payoff[i] = visitPayoff < base ? base : visitPayoff;
+        host_payoff[i] = hostPayoff < base ? base : hostPayoff;
+    }
+}
+
+// Learning parameters of a run. The .conf row sets them identically for every agent,
+// so they are read off one.
+struct LearningParams{
+    float strategy_learning_speed;
+    float network_learning_speed;
+    float strategy_discount;
+    float network_discount;
+    float strategy_tremble;
+    float network_tremble;
+    bool net_learn;
+    bool net_sym;
+    bool strat_sym;
+
+    explicit LearningParams(Agent &agent);
+};
+
+// Run Kernel<Rank, Coupling>::run(args...) with the policies of a run's rank model and
+// the game's coupling function. Every engine goes through this one switch.
+template<template<class, class> class Kernel, class Rank, class... Args>
+void dispatch_coupling(Game &g, Args&... args){
+    switch(g.getCouplingType()){
+        case COUPLING_FIGHT:
+            Kernel<Rank, FightCoupling>::run(args...);
+            break;
+        case COUPLING_FIGHTSPLIT:
+            Kernel<Rank, FightSplitCoupling>::run(args...);
+            break;
+        case COUPLING_FIGHTRAND:
+            Kernel<Rank, FightRandCoupling>::run(args...);
+            break;
+        case COUPLING_STAGHUNT:
+            Kernel<Rank, StagHuntCoupling>::run(args...);
+            break;
+        case COUPLING_FSH:
+            Kernel<Rank, FSHCoupling>::run(args...);
+            break;
+        case COUPLING_NONE:
+            Kernel<Rank, NoCoupling>::run(args...);
+            break;
+        default:
+            std::cerr << "Error: unknown coupling effect " << g.getCouplingEffect() << "\n";
+            _Exit(1);
+    }
+}
+
+template<template<class, class> class Kernel, class... Args>
+void dispatch_model(RankModel rank_model, Game &g, Args&... args){
+    switch(rank_model){
+        case RANK_STATIC:
+            dispatch_coupling<Kernel, StaticRank>(g, args...);
+            break;
+        case RANK_DYNAMIC:
+            dispatch_coupling<Kernel, DynamicRank>(g, args...);
+            break;
+        default:
+            std::cerr << "Error: unknown rank model\n";
+            _Exit(1);
+    }
+}
+
+class Environment{
+    private:
+        int size;
+    
+};
+
+// EvoStats kernel: adds weight x p1[a] x p2[b] / pop to the share of interaction type
+// k * a + b, over the k x k pairs of visitor strategy a and host strategy b.  K is k
+// when it is known at compile time (2x2 games), 0 to take num_strats.
+template<int K>
+inline void addInteractionShares(double *shares, double weight, const double *p1, const double *p2, int num_strats, int pop){
+    const int k = K ? K : num_strats;
+    for(int a = 0; a < k; a++){
+        for(int b = 0; b < k; b++){
+            shares[k * a + b] += (weight * p1[a] * p2[b])/pop;
+        }
+    }
+}
+
+struct SimTracking{
+    char key[20];
+    const char out_folder_complete_path[100] = "/Users/bobloblaw/Dropbox/Research/Evolutionary_Modeling";
+    int current_seed;
+    uint32_t stream_seed; // Hash of the seed, seed index and the key's stream group, which seeds the streams below and the counter streams
+    MersenneRNG shuffle_rng; // The run's own stream for the agent shuffle (seeded per run in main)
+    
+    std::string out_network_file;
+    std::string out_stats_file;
+    std::string out_p1strat_file;
+    std::string out_p2strat_file;
+    std::string out_innov_scores;
+    std::string out_innov_locs;
+    std::string out_partners;
+    std::string out_p1_payoffs;
+    std::string out_p2_payoffs;
+    std::string out_net_stds;
+    std::string out_substrate;
+    std::string out_full_strats;
+    std::string out_inscore;
+    std::string out_tp_file;
+    std::string out_inter_file;
+    
+    std::vector<std::vector<double>> player_strategies_p1_t;
+    std::vector<std::vector<double>> player_strategies_p2_t;
+    std::vector<std::vector<double>> network_weights_t;
+    
+    std::vector<std::vector<double>> network_stds_t;
+    std::vector<std::vector<double>> full_strats_t;
+    std::vector<std::vector<int>> innov_score_t;
+    
+    std::vector<std::vector<double>> total_payoffs_t;
+    
+    std::vector<std::vector<int>> all_interactions_t;
+
+    
+    std::vector<std::vector<double>> player_p1_payoffs_t;
+    std::vector<std::vector<double>> player_p2_payoffs_t;
+    std::vector<std::vector<int>> player_partners_t;
+    std::vector<double> strategy_correlation_t;
+    std::vector<std::vector<double>> prop_interactions_t;
+    std::vector<std::vector<double>> strategy_mean_t;
+    std::vector<std::vector<double>> strategy_variance_t;
+    std::vector<double> instrength_variance_t;
+    std::vector<int> times_tracked;
+    
+    std::vector<std::vector<int>> innovation_locations_t;
+    std::vector<std::vector<double>> innovation_scores_t;
+    
+    int max_time;
+    int run_threads = 1; // Threads sharing each timestep of this run (batched timestep)
+    
+    std::string out_file_evostats;
+    
+    // Per-step scratch, reused so that steps which record nothing do not allocate
+    std::vector<double> player_strategies_p1;
+    std::vector<double> player_strategies_p2;
+    std::vector<double> prop_interactions;
+    std::vector<double> network_weights;
+    std::vector<double> innovation_scores;
+    std::vector<int> innovation_locations;
+    std::vector<double> player_p1_payoffs;
+    std::vector<double> player_p2_payoffs;
+    std::vector<int> player_partners;
+    std::vector<double> total_payoffs;
+    std::vector<int> all_interactions;
+    std::vector<double> innovation_sorted;
+    std::vector<double> player1_std;
+    
+    // Steps at which updateData appends to the *_t trackers
+    template<class Rank>
+    bool isRecorded(int time_t){
+        return (Rank::track_ranks && (time_t % 10) == 0) || (std::find(times_tracked.begin(), times_tracked.end(), time_t) != times_tracked.end());
+    }
+    
+    void init_Trackers(int pop, int num_strats, const Substrate &substrate = Substrate()){
+        times_tracked = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 15, 20, 25, 50, 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000, 2000, 3000, 4000, 5000, 6000,
+            7000, 8000, 9000, 10000, 20000, 30000, 40000, 50000, 60000, 70000, 80000, 90000, 100000, 110000, 120000, 130000, 140000, 150000, 160000, 170000, 180000, 190000, 200000, 210000, 220000, 230000, 240000, 250000, 260000, 270000, 280000, 290000, 300000, 310000, 320000, 330000, 340000, 350000, 360000, 370000, 380000, 390000, 400000, 410000, 420000, 430000, 440000, 450000, 460000, 470000, 480000, 490000, 500000, 550000, 600000, 650000, 700000, 750000, 800000, 900000, 1000000};          
+        
+#ifdef USE_MPI
+        // Only process 0 keeps tracker output
+        if(processRank() != 0){
+            return;
+        }
+#endif
+        
+        // Strategy initialization
+        std::vector<double> init_strategy(pop*num_strats);
+        std::fill(init_strategy.begin(),init_strategy.end(),1.0/num_strats);
+        player_strategies_p1_t.push_back(init_strategy);
+        player_strategies_p2_t.push_back(init_strategy);
+        
+        // Network initialization
+#ifdef SPARSE_NETWORK
+        // Per agent: SPARSE_NETWORK (partner, weight) pairs, unused ones (-1, 0), then the rest mass
+        std::vector<double> init_netweights;
+        init_netweights.reserve((size_t) pop * (2 * SPARSE_NETWORK + 1));
+        for(int i = 0; i < pop; i++){
+            for(int k = 0; k < SPARSE_NETWORK; k++){
+                init_netweights.push_back(-1);
+                init_netweights.push_back(0);
+            }
+            init_netweights.push_back(1);
+        }
+#else
+        std::vector<double> init_netweights;
+        if(substrate.complete()){
+            init_netweights.assign(pop*pop, 1.0/(pop-1));
+            for(int i = 0; i < pop; i++){
+                init_netweights.at(i * pop + i) = 0;
+            }
+        }else{
+            // One entry per edge, in substrate order
+            for(int i = 0; i < pop; i++){
+                init_netweights.insert(init_netweights.end(), substrate.degree(i), 1.0/substrate.degree(i));
+            }
+        }
+#endif
+        network_weights_t.push_back(init_netweights);
+        //std::vector<std::vector<double>> player_payoffs_t;
+        //std::vector<double> strategy_correlation_t;
+        std::vector<double> init_interactions(1 + num_strats*num_strats, 1.0/(num_strats*num_strats));
+        init_interactions.at(0) = 0;
+        prop_interactions_t.push_back(init_interactions);
+        //std::vector<std::vector<double>> strategy_mean_t;
+        //std::vector<std::vector<double>> strategy_variance_t;
+        //std::vector<double> instrength_variance_t;
+        
+    }
+    
+    template<class Rank>
+    void updateData(Network &net, UGenerator &rng, NGenerator &nrng, int time_t){
+        int pop = net.getPop();
+        
+        Population &popdata = net.getPopulation();
+        int num_inter = popdata.num_interactions;
+        int num_strats = popdata.num_strats;
+        
+        player_strategies_p1.clear();
+        player_strategies_p1.reserve(pop*num_strats);
+        
+        player_strategies_p2.clear();
+        player_strategies_p2.reserve(pop*num_strats);
+        
+        prop_interactions.assign(1 + num_inter,0.0);
+        
+        network_weights.clear();
+#ifdef SPARSE_NETWORK
+        network_weights.reserve((size_t) pop * (2 * SPARSE_NETWORK + 1));
+#else
+        network_weights.reserve(net.getPopulation().cur_weights.size());
+#endif
+        
+        innovation_scores.clear();
+        innovation_scores.reserve(pop);
+        
+        innovation_locations.clear();
+        innovation_locations.reserve(pop);
+        
+        player_p1_payoffs.clear();
+        player_p1_payoffs.reserve(pop);
+        
+        player_p2_payoffs.clear();
+        player_p2_payoffs.reserve(pop);
+        
+        player_partners.clear();
+        player_partners.reserve(pop);
+        
+        total_payoffs.clear();
+        total_payoffs.reserve(pop);
+        
+        all_interactions.clear();
+        
+        all_interactions.reserve(pop * num_inter);
+        
+        bool track_ranks = Rank::track_ranks && (time_t % 10) == 0;
+        bool tracked_time = std::find(times_tracked.begin(), times_tracked.end(), time_t) != times_tracked.end();
+        
+        // Per-agent values of the held agents (all of them unless distributed)
+        int first = popdata.row_begin;
+        int last = popdata.row_end;
+        
+        for(int agent_num = first; agent_num < last; agent_num++){
+            
+            Agent &curAgent = net.GetAgent(agent_num);
+            //curAgent.exploreSpace(1,rng,nrng,space_data);
+            curAgent.updateAgent();
+            Rank::commitScore(popdata, agent_num);
+            
+            const int *agent_interactions = popdata.agentInteractions(agent_num);
+            
+            all_interactions.insert(all_interactions.end(), agent_interactions, agent_interactions + num_inter);
+            
+            // Update visitor strategy tracker
+            const weight_t *p1_strats = popdata.curStrats(agent_num, 0);
+            double p1_strat_sum = std::accumulate(p1_strats, p1_strats + num_strats, 0.0);
+            for(int s = 0; s < num_strats; s++){
+                player_strategies_p1.push_back(p1_strats[s] * (1.0/p1_strat_sum));
+            }
+            
+            // Update host strategy tracker
+            const weight_t *p2_strats = popdata.curStrats(agent_num, 1);
+            double p2_strat_sum = std::accumulate(p2_strats, p2_strats + num_strats, 0.0);
+            for(int s = 0; s < num_strats; s++){
+                player_strategies_p2.push_back(p2_strats[s] * (1.0/p2_strat_sum));
+            }
+            
+            // Update network tracker
+#ifdef SPARSE_NETWORK
+            const SparseRow &row = popdata.curRow(agent_num);
+            double net_sum = std::accumulate(row.weight, row.weight + row.count, 0.0) + row.rest;
+            for(int k = 0; k < SPARSE_NETWORK; k++){
+                network_weights.push_back(k < row.count ? row.partner[k] : -1);
+                network_weights.push_back(k < row.count ? row.weight[k] * (1.0/net_sum) : 0);
+            }
+            network_weights.push_back(row.rest * (1.0/net_sum));
+#else
+            const weight_t *friends = popdata.curFriends(agent_num);
+            int row_len = popdata.rowLength(agent_num);
+            double net_sum = std::accumulate(friends, friends + row_len, 0.0);
+            for(int j = 0; j < row_len; j++){
+                network_weights.push_back(friends[j] * (1.0/net_sum));
+            }
+#endif
+            
+            double score = curAgent.getScore();
+
+            innovation_scores.push_back(score);
+            
+            int location = curAgent.getLocationInt();
+            innovation_locations.push_back(location);
+            
+            total_payoffs.push_back(Rank::totalPayoffs(popdata)[agent_num]);
+            
+            player_p1_payoffs.push_back(curAgent.getPastVisitPayoff());
+            player_p2_payoffs.push_back(curAgent.getPastHostPayoff());
+            player_partners.push_back(curAgent.getPastVisitPartner());
+        }
+        
+#ifdef USE_MPI
+        // Next step's draws need every committed strategy, and EvoStats every host strategy
+        syncCommitted(popdata);
+        gatherRows(player_strategies_p2, true);
+#endif
+        
+        // NetSTD: incoming weight per agent, summed over the held rows
+        if(track_ranks){
+            player1_std.assign(pop, 0.0);
+        }
+                
+#ifdef SPARSE_NETWORK
+        // Implicit partners' host strategies: population total less self and the explicit partners
+        const int row_len = 2 * SPARSE_NETWORK + 1;
+        std::vector<double> p2_total(num_strats, 0.0);
+        std::vector<double> visited_p2(num_strats);
+        std::vector<double> implicit_p2(num_strats);
+        for(int pop_ind = 0; pop_ind < pop; pop_ind++){
+            for(int s = 0; s < num_strats; s++){
+                p2_total[s] += player_strategies_p2.at(pop_ind * num_strats + s);
+            }
+        }
+        
+        // NetSTD: each implicit share counted for everyone, then corrected
+        double uniform_total = 0;
+#endif
+        for(int pop_ind_1 = first; pop_ind_1 < last; pop_ind_1++){
+            // Index among the held agents' per-agent values
+            int held_ind = pop_ind_1 - first;
+#ifdef SPARSE_NETWORK
+            const double *row_weights = &network_weights.at((size_t) held_ind * row_len);
+            int count = popdata.curRow(pop_ind_1).count;
+            int implicit = pop - 1 - count;
+            double implicit_share = implicit > 0 ? row_weights[row_len - 1] / implicit : 0;
+            
+            for(int s = 0; s < num_strats; s++){
+                visited_p2[s] = 0;
+                implicit_p2[s] = p2_total[s] - player_strategies_p2.at(pop_ind_1 * num_strats + s);
+            }
+            for(int k = 0; k < count; k++){
+                int partner = (int) row_weights[2 * k];
+                for(int s = 0; s < num_strats; s++){
+                    visited_p2[s] += row_weights[2 * k + 1] * player_strategies_p2.at(partner * num_strats + s);
+                    implicit_p2[s] -= player_strategies_p2.at(partner * num_strats + s);
+                }
+                if(track_ranks){
+                    player1_std.at(partner) += row_weights[2 * k + 1] - implicit_share;
+                }
+            }
+            for(int strat_1 = 0; strat_1 < num_strats; strat_1++){
+                for(int strat_2 = 0; strat_2 < num_strats; strat_2++){
+                    prop_interactions.at(num_strats * strat_1 + strat_2 + 1) += (player_strategies_p1.at(held_ind * num_strats + strat_1) * (visited_p2[strat_2] + implicit_share * implicit_p2[strat_2]))/pop;
+                }
+            }
+            if(track_ranks){
+                player1_std.at(pop_ind_1) -= implicit_share;
+                uniform_total += implicit_share;
+            }
+#else
+            // Row of pop_ind_1's links (every agent, or its substrate neighbors), in held row order
+            size_t row_start = popdata.rowStart(pop_ind_1);
+            int row_len = popdata.rowLength(pop_ind_1);
+            for(int column = 0; column < row_len; column++){
+                int pop_ind_2 = popdata.partnerAt(pop_ind_1, column);
+                double weight = network_weights.at(row_start + column);
+                if(num_strats == 2){
+                    addInteractionShares<2>(&prop_interactions.at(1), weight, &player_strategies_p1.at(held_ind * 2), &player_strategies_p2.at(pop_ind_2 * 2), 2, pop);
+                }else{
+                    addInteractionShares<0>(&prop_interactions.at(1), weight, &player_strategies_p1.at(held_ind * num_strats), &player_strategies_p2.at(pop_ind_2 * num_strats), num_strats, pop);
+                }
+                if(track_ranks){
+                    player1_std[pop_ind_2] += network_weights.at(row_start + column);
+                }
+            
+            }
+#endif
+        }
+        
+#ifdef USE_MPI
+        // Sums over all rows and per-agent values of all agents, on process 0
+        sumToRoot(&prop_interactions.at(1), num_inter);
+        if(track_ranks){
+            sumToRoot(player1_std.data(), pop);
+    #ifdef SPARSE_NETWORK
+            sumToRoot(&uniform_total, 1);
+    #endif
+        }
+        gatherRows(player_strategies_p1);
+        gatherRows(innovation_scores);
+        if(tracked_time){
+            gatherRows(network_weights);
+            gatherRows(innovation_locations);
+            gatherRows(player_p1_payoffs);
+            gatherRows(player_p2_payoffs);
+            gatherRows(player_partners);
+            gatherRows(all_interactions);
+            gatherRows(total_payoffs);
+        }
+        if(processRank() != 0){
+            return;
+        }
+#endif
+        prop_interactions.at(0) = time_t;
+        
+        if(track_ranks){
+            innovation_sorted.assign(innovation_scores.begin(), innovation_scores.end());
+            
+            std::sort(innovation_sorted.begin(), innovation_sorted.end());
+            
+            for(int agent_num = 0; agent_num < pop; agent_num++){
+                std::vector<double> hawk_strats;
+                hawk_strats.push_back(player_strategies_p1.at(agent_num * num_strats));
+                hawk_strats.push_back(player_strategies_p2.at(agent_num * num_strats));
+                full_strats_t.push_back(hawk_strats);
+                
+                auto iter = std::lower_bound(innovation_sorted.begin(), innovation_sorted.end(), innovation_scores.at(agent_num));
+                int rank_index = int(iter - innovation_sorted.begin());
+                std::vector<int> this_inscore;
+                this_inscore.push_back(rank_index);
+                
+                innov_score_t.push_back(this_inscore);
+            }
+        }
+        
+        //double mean = sum / player1_std.size();
+        
+        //std::vector<double> diff(player1_std.size());
+            
+        //std::transform(player1_std.begin(), player1_std.end(), diff.begin(), [mean](double x) { return x - mean; });
+        
+        //double sq_sum = std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0);
+        //double stdev = std::sqrt(sq_sum / player1_std.size());
+ 
+                        
+        if(tracked_time){
+            prop_interactions_t.push_back(prop_interactions);
+            player_strategies_p1_t.push_back(player_strategies_p1);
+            player_strategies_p2_t.push_back(player_strategies_p2);
+            network_weights_t.push_back(network_weights);
+            player_p1_payoffs_t.push_back(player_p1_payoffs);
+            player_p2_payoffs_t.push_back(player_p2_payoffs);
+            player_partners_t.push_back(player_partners);
+            innovation_scores_t.push_back(innovation_scores);
+            innovation_locations_t.push_back(innovation_locations);
+            all_interactions_t.push_back(all_interactions);
+            total_payoffs_t.push_back(total_payoffs);
+        }
+        
+        if(track_ranks){
+#ifdef SPARSE_NETWORK
+            std::vector<double> stdev_vec(player1_std);
+            for(int i = 0; i < pop; i++){
+                stdev_vec[i] += uniform_total;
+            }
+            network_stds_t.push_back(stdev_vec);
+#else
+            network_stds_t.push_back(player1_std);
+#endif
+        }
+        
+        
+    };
+    template<class Rank>
+    void initTrackLocation(Network &net, UGenerator &rng, NGenerator &nrng){
+
+        int pop = net.getPop();
+        
+        std::vector<double> innovation_scores;
+        innovation_scores.reserve(pop);
+        
+        std::vector<int> innovation_locations;
+        innovation_locations.reserve(pop);
+        
+        for(int agent_num = 0; agent_num < pop; agent_num++){
+            
+            net.agent_seq.push_back(agent_num);
+            
+            Agent &curAgent = net.GetAgent(agent_num);
+            
+            if(Rank::random_init){
+                #ifdef COUNTER_RNG
+                    CounterStream score_rng(stream_seed, 0, agent_num, DRAW_INIT_SCORE);
+                    curAgent.setInitScore(score_rng);
+                #else
+                    curAgent.setInitScore(rng);
+                #endif
+            }
+            double score = curAgent.getScore();
+            innovation_scores.push_back(score);
+            
+            int location = curAgent.getLocationInt();
+            innovation_locations.push_back(location);
+            
+        }
+       
+        innovation_scores_t.push_back(innovation_scores);
+        innovation_locations_t.push_back(innovation_locations);
+    
+    };
+    // =snprintf("%s/%s_StrategyP1t_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+    //snprintf(out_file_p2t,sizeof(out_file_p2t),"%s/%s_StrategyP2t_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+    //snprintf(out_file_p1_s1_t,sizeof(out_file_p1_s1_t),"%s/%s_ActionsP1t_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+    //snprintf(out_file_p2_s1_t,sizeof(out_file_p2_s1_t),"%s/%s_ActionsP2t_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+    // snprintf(out_file_stats,sizeof(out_file_stats),"%s/%s_EvoStats_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+    //snprintf(out_file_payoffs_p1_t,sizeof(out_file_payoffs_p1_t),"%s/%s_PayoffsP1t_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+    //snprintf(out_file_payoffs_p2_t,sizeof(out_file_payoffs_p2_t),"%s/%s_PayoffsP2t_%s_%d.csv",out_folder_complete_path,game,key,seeds[seed_ind]);
+};
+
+// Lockstep ensembles
+// With -DENSEMBLE=S (only together with COUNTER_RNG) the seeds of a key run S at a
+// time as one ensemble: every replica's state is stored replica-minor (entry i of
+// replica r at i * S + r), so the Philox draws, partner scans, strategy draws and
+// payoffs of one agent are computed for all S replicas in one vectorizable loop.
+// Each replica keeps its own counter streams, so its trajectory and output are the
+// same as its seed run alone.  Keys the ensemble does not cover (substrate graphs,
+// populations that use the sum tree sampler) run one seed at a time as before.
+#ifdef ENSEMBLE
+    #ifndef COUNTER_RNG
+        #error "ENSEMBLE draws every replica from its own counter streams, which needs COUNTER_RNG"
+    #endif
+    #if defined(SPARSE_NETWORK) || defined(USE_MPI) || defined(TREMBLE_SKIP)
+        #error "ENSEMBLE keeps dense rows for whole populations in one process, build without SPARSE_NETWORK, USE_MPI and TREMBLE_SKIP"
+    #endif
+
+// One seed run of an ensemble: its streams, trackers and network (the output copy of
+// its replica, written on recorded steps)
+struct EnsembleMember{
+    UGenerator *rng;
+    NGenerator *nrng;
+    SimTracking *tracking_vars;
+    Network *net;
+};
+
+// Whether the ensemble engine can run this key's network
+bool ensembleSupports(Network &net);
+
+// Run the members (seeds of one key, at most ENSEMBLE) in lockstep to their max_time
+void run_ensemble(Game &g, std::vector<EnsembleMember> &members, RankModel rank_model);
+#endif
+
+// Tau leaping
+// With -DTAU_LEAP=tol each run advances several timesteps at a time, an approximation
+// for screening parameter regions before exact runs.  A leap freezes the committed
+// partner and strategy probabilities, draws how many times each visitor meets each
+// host with each pair of strategies over the leap, and applies the summed payoffs
+// with the leap's compounded discount.  Leap lengths adapt so that no network row's or
+// strategy set's choice probabilities are expected to drift by more than tol in one
+// leap (at most TAU_LEAP_MAX_STEPS steps), and leaps end at every recorded step.
+// Leaps save work only where visits repeat within a leap, i.e. in small populations:
+// from SAMPLER_TREE_MIN_POP agents on, short leaps still draw every visit on its own
+// and cost about as much as exact steps, or more.
+#ifdef TAU_LEAP
+    #if defined(SPARSE_NETWORK) || defined(USE_MPI) || defined(ENSEMBLE)
+        #error "TAU_LEAP runs one simulation at a time on dense rows, build without SPARSE_NETWORK, USE_MPI and ENSEMBLE"
+    #endif
+    #ifndef TAU_LEAP_MAX_STEPS
+        #define TAU_LEAP_MAX_STEPS 1000
+    #endif
+
+// Run a simulation to its max_time in leaps
+void run_tau_leap(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, RankModel rank_model);
+#endif
+
+// Mean field
+// With -DMEAN_FIELD=tol each run integrates the expected dynamics instead of drawing
+// them: the network, strategy and payoff totals follow an ODE whose rate is the expected
+// change of one timestep (each link, strategy pair and coupling draw weighted by its
+// chance, with the payoffs from Game::playBatch).  An adaptive Dormand-Prince
+// Runge-Kutta method keeps each step's relative error below tol (steps below
+// MEAN_FIELD_MIN_STEP timesteps are taken regardless), and the state is written to
+// the population at every recorded step.  Results do not depend on the seed, apart from
+// static ranks' initial scores.  Each rate evaluation costs links x strategy pairs, so
+// from a few hundred agents on a run costs more than an exact one.
+#ifdef MEAN_FIELD
+    #if defined(SPARSE_NETWORK) || defined(USE_MPI) || defined(ENSEMBLE) || defined(TAU_LEAP)
+        #error "MEAN_FIELD runs one simulation at a time on dense rows, build without SPARSE_NETWORK, USE_MPI, ENSEMBLE and TAU_LEAP"
+    #endif
+    #ifndef MEAN_FIELD_MIN_STEP
+        #define MEAN_FIELD_MIN_STEP 0.01
+    #endif
+
+// Run a simulation to its max_time by integrating its expected dynamics
+void run_mean_field(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, RankModel rank_model);
+#endif
@@ -0,0 +1,1096 @@
+#define NK_LEN 1048576
+
+// If compiled with -fopenmp, include omp (for multithreading)
+#ifdef _OPENMP
+    #include <omp.h>
+#else
+    #define omp_get_thread_num() 0
+    #define omp_get_max_threads() 1
+    #define omp_get_num_threads() 1
+#endif
+
+/* A test driver for the Network class (NetworkDriver.cpp) */
+#include <stdio.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <memory>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <algorithm>
+#include <bitset>
+#include <iomanip>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include "Network.h"   // using Network class
+
+// Allocation check: build with -DALLOC_CHECK to count heap allocations per timestep
+// and report any step that allocates without recording tracker output (the program
+// then exits with status 1).  The count is process-wide, so it includes the threads
+// sharing a simulation's timesteps; run one simulation at a time (THREADS 1) for the
+// per-step counts to be the simulation's own.
+#ifdef ALLOC_CHECK
+    #include <new>
+    #include <cstdlib>
+    #include <atomic>
+
+    static std::atomic<long> alloc_count(0);
+    static std::atomic<bool> alloc_check_failed(false);
+
+    // Every replaceable form, so each allocation pairs with a matching deallocation.
+    // Kept out of line: inlined, GCC flags the free of what it sees as new's memory.
+    __attribute__((noinline)) void* operator new(std::size_t size){
+        alloc_count.fetch_add(1, std::memory_order_relaxed);
+        void *ptr = std::malloc(size ? size : 1);
+        if(!ptr){
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+    __attribute__((noinline)) void* operator new[](std::size_t size){
+        return operator new(size);
+    }
+    __attribute__((noinline)) void operator delete(void *ptr) noexcept{
+        std::free(ptr);
+    }
+    __attribute__((noinline)) void operator delete[](void *ptr) noexcept{
+        operator delete(ptr);
+    }
+    __attribute__((noinline)) void operator delete(void *ptr, std::size_t) noexcept{
+        operator delete(ptr);
+    }
+    __attribute__((noinline)) void operator delete[](void *ptr, std::size_t) noexcept{
+        operator delete(ptr);
+    }
+#endif
+
+// With -DALLOC_CHECK_PROBE, the threads other than the first that commit a step allocate
+// on purpose, so check_allocations.sh can show that the check sees those threads
+#if defined(ALLOC_CHECK) && defined(ALLOC_CHECK_PROBE)
+    #define alloc_check_probe() if(omp_get_thread_num() != 0){ int *volatile probe = new int(0); delete probe; }
+#else
+    #define alloc_check_probe()
+#endif
+
+template <typename Stream, typename Iter, typename Infix>
+inline Stream& infix (Stream &os, Iter from, Iter to, Infix infix_) {
+    if (from == to) return os;
+    os << *from;
+    for (++from; from!=to; ++from) {
+        os << infix_ << *from;
+    }
+    return os;
+}
+
+template <typename Stream, typename Iter>
+inline Stream& comma_seperated (Stream &os, Iter from, Iter to) {
+    return infix (os, from, to, ", ");
+}
+
+
+// One seed of one key: its streams, game, network and trackers
+struct SimRun{
+    Engine eng;
+    UGenerator rng;
+    NGenerator nrng;
+    std::unique_ptr<Game> game;
+    std::unique_ptr<Network> net;
+    int net_pop;
+    Substrate substrate;
+    RankModel rank_model;
+    SimTracking tracking_vars;
+    
+    SimRun(int seed, float innov_noise) : eng(seed), rng(eng, UDistribution(0.0, 1.0)), nrng(eng, NDistribution(0.0, innov_noise)), net_pop(0), rank_model(RANK_UNKNOWN) {}
+};
+
+std::unique_ptr<SimRun> setup_run(const std::vector<std::string> &these_inputs, const std::string &full_input_folder, int this_seed, int base_seed, int seed_ind, int ruggednessk, int run_threads);
+void write_outputs(SimRun &run);
+void run_group(std::vector<std::unique_ptr<SimRun>> &runs);
+void run_model(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, RankModel rank_model);
+template<class Rank, class Coupling>
+struct CoupledModel{
+    static void run(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net);
+};
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_kernel(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net);
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_timestep(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, int t, std::vector<int> &agent_seq);
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_batched_timestep(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, int t, std::vector<int> &agent_seq, InteractionBatch &batch);
+void shuffle_agents(SimTracking &tracking_vars, Network &net, int t, std::vector<int> &agent_seq);
+uint32_t run_stream_seed(int seed, const std::string &key, int seed_ind);
+bool is_number(const std::string& s);
+bool file_exists (const std::string& name);
+
+int main(int argc, char *argv[]){
+    
+    #ifdef USE_MPI
+        startProcesses(&argc, &argv);
+    #endif
+    
+    // Command line arguments at runtime
+    char* inputFolder = argv[1]; // Name of input file (decide to include folder here)
+    char* inputFileNumber = argv[2];  // Input file number
+    int thread_ct = atoi(argv[3]); // Number of threads to run in parallel if fopenmp
+    int num_seeds = atoi(argv[4]); // Number of seeds to run
+    int base_seed = atoi(argv[5]); // Starting at this seed
+    int start_key = atoi(argv[6]); // Starting at this key index
+    int ruggednessk = atoi(argv[7]);
+    int run_threads = argc > 8 ? atoi(argv[8]) : 1; // Threads splitting each simulation's timesteps (optional)
+    
+    #ifdef USE_MPI
+        // Every process takes part in every simulation, so they run one at a time
+        thread_ct = 1;
+    #endif
+    
+   /*
+    time_tracker1 = atoi(argv[8]);
+    time_tracker2 = atoi(argv[9]);
+    time_tracker3 = atoi(argv[10]);
+    burn_in_time = atoi(argv[11]);
+     */
+    
+   
+    
+    
+    // Read in seeds
+    //////////////////////////////////////////////////////
+
+    std::ifstream seedfile("../Helpers/ESD_Seeds_All_Ordered.csv");
+    
+    if (seedfile.fail()){
+        std::cerr << "Error: " << strerror(errno) << "\n";
+        _Exit(1);
+    }
+    
+    std::vector<int> seeds;
+    
+    int seed_value;
+    
+    while (seedfile >> seed_value) {
+        seeds.push_back(seed_value);
+    }
+    
+    ////////////////////////////////////////////////////// End read
+
+
+    // Read input file line by line
+    std::string full_input_folder = string_format("HDInnov_Input/Input_HDInnov_%s",inputFolder);
+    std::string inputFilename = string_format("%s/Input_HDInnov_%s_%s.conf",full_input_folder.c_str(),inputFolder,inputFileNumber);
+    std::ifstream in(inputFilename);
+    
+    std::cout << inputFilename << "\n";
+
+    if (in.fail()){
+        std::cerr << "Error: " << strerror(errno) << "\n";
+    }
+
+    std::vector<std::vector<std::string>> all_inputs;
+    
+    std::string header;
+    getline(in, header);
+    
+    if (in) {
+        std::string line;
+        
+        while (std::getline(in, line)) {
+            all_inputs.push_back(std::vector<std::string>());
+            
+            // Break down the row into column values
+            std::stringstream split(line);
+            std::string value;
+            
+            while (split >> value)
+                all_inputs.back().push_back(value);
+        }
+    }
+    
+    ////////////////////////////////////////////////////// End read
+
+    
+    // Number of keys is number of lines, or size of all inputs first dimension
+    int num_keys = (int) all_inputs.size();
+    
+    // Seeds of a key run ENSEMBLE at a time in lockstep, or one at a time by default
+    #ifdef ENSEMBLE
+        const int group_size = ENSEMBLE;
+    #else
+        const int group_size = 1;
+    #endif
+    int groups_per_key = (num_seeds + group_size - 1) / group_size;
+    
+    #ifdef _OPENMP
+    {
+        #pragma omp parallel for num_threads(thread_ct) //start thread_ct parallel for loops (each is one group of simulations)
+    #endif
+        for(int seed_group = groups_per_key*start_key; seed_group < num_keys * groups_per_key; seed_group++)
+        {
+            // Set key index and the group's seed indices
+            int run_num = seed_group/groups_per_key;
+            int first_seed = (seed_group%groups_per_key) * group_size;
+            int last_seed = std::min(first_seed + group_size, num_seeds);
+            
+            std::vector<std::unique_ptr<SimRun>> runs;
+            for(int seed_ind = first_seed; seed_ind < last_seed; seed_ind++){
+                // Locate seed at the index
+                int this_seed = seeds.at(base_seed + seed_ind);
+                
+                std::unique_ptr<SimRun> run = setup_run(all_inputs.at(run_num), full_input_folder, this_seed, base_seed, seed_ind, ruggednessk, run_threads);
+                if(run){
+                    runs.push_back(std::move(run));
+                }
+            }
+            
+            run_group(runs);
+            
+            for(size_t run_ind = 0; run_ind < runs.size(); run_ind++){
+                write_outputs(*runs[run_ind]);
+            }
+        }
+    #ifdef _OPENMP
+        }
+    #endif
+    
+    #ifdef USE_MPI
+        stopProcesses();
+    #endif
+    
+    #ifdef ALLOC_CHECK
+        if(alloc_check_failed){
+            return 1;
+        }
+    #endif
+            
+    return 0;
+}
+
+
+// Read a key's inputs and build its run for one seed, or nothing if its outputs already exist
+std::unique_ptr<SimRun> setup_run(const std::vector<std::string> &these_inputs, const std::string &full_input_folder, int this_seed, int base_seed, int seed_ind, int ruggednessk, int run_threads){
+    // Grab input vector and set Input parameters
+    ////////////////////////////////////////////
+    
+    double base_in = std::stod(these_inputs.at(0));
+        
+    int tmax_in = std::stoi(these_inputs.at(2));
+    float netdiscount_in = std::stof(these_inputs.at(3));
+    float stratdiscount_in = std::stof(these_inputs.at(4));
+    float netlearningspeed_in = std::stof(these_inputs.at(5));
+    float stratlearningspeed_in = std::stof(these_inputs.at(6));
+    bool netsymmetric_in = boost::lexical_cast<bool>(these_inputs.at(7));
+    bool stratsymmetric_in = boost::lexical_cast<bool>(these_inputs.at(8));
+    float nettremble_in = std::stof(these_inputs.at(9));
+    float strattremble_in = std::stof(these_inputs.at(10));
+    float score_copy_prob = std::stof(these_inputs.at(11));
+    float copy_error = std::stof(these_inputs.at(12));
+    float explore_prob = std::stof(these_inputs.at(13));
+    float innov_noise  = std::stof(these_inputs.at(14));
+    std::string coupling_effect = these_inputs.at(15);
+    std::string game_in = these_inputs.at(16);
+    std::string outputDesc = these_inputs.at(17);
+    std::string key = these_inputs.at(18);
+    
+    if(these_inputs.size() < 20){
+        std::cerr << "Error: no RankModel (Static or Dynamic) given for key " << key << "\n";
+        _Exit(1);
+    }
+    std::string rank_model_in = these_inputs.at(19);
+    RankModel rank_model = parseRankModel(rank_model_in);
+    if(rank_model == RANK_UNKNOWN){
+        std::cerr << "Error: unknown rank model " << rank_model_in << "\n";
+        _Exit(1);
+    }
+    
+    // Optional interaction substrate (by default everyone can visit everyone)
+    std::string substrate_in = these_inputs.size() > 20 ? these_inputs.at(20) : "Complete";
+    
+    // Optional stream group: keys in the same group draw the same random numbers for a
+    // seed (by default each key is its own group)
+    std::string streams_in = these_inputs.size() > 21 ? these_inputs.at(21) : key;
+    
+    std::string mainOutputFolder = string_format("%s_Output_Data",game_in.c_str());
+
+    std::string outputFolder = string_format("%s_Output_Data/Output_%s",game_in.c_str(),outputDesc.c_str());
+    
+    std::string strat_file = string_format("%s/Strategy/Strategy_%s.csv",full_input_folder.c_str(),key.c_str());
+    
+    struct stat st = {0};
+    
+    // If output directory doesn't exist, create it
+    if(stat(mainOutputFolder.c_str(), &st) == -1){
+        mkdir(mainOutputFolder.c_str(), 0700);
+    }
+
+    // If output directory doesn't exist, create it
+    if(stat(outputFolder.c_str(), &st) == -1){
+        mkdir(outputFolder.c_str(), 0700);
+    }
+    
+    ////////////////////////////////////////////
+    
+    
+    // Initialize tracking variables
+    std::unique_ptr<SimRun> run(new SimRun(this_seed, innov_noise));
+    SimTracking &tracking_vars = run->tracking_vars;
+    
+    tracking_vars.out_network_file = string_format("%s/%s_Weights_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_stats_file = string_format("%s/%s_EvoStats_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_p1strat_file = string_format("%s/%s_StrategyVisit_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_p2strat_file = string_format("%s/%s_StrategyHost_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_innov_scores = string_format("%s/%s_Scores_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_innov_locs = string_format("%s/%s_Locations_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_p1_payoffs = string_format("%s/%s_P1Payoffs_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_p2_payoffs = string_format("%s/%s_P2Payoffs_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_partners = string_format("%s/%s_Partners_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_net_stds = string_format("%s/%s_NetSTD_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_full_strats = string_format("%s/%s_OutFS_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    tracking_vars.out_inscore = string_format("%s/%s_OutScore_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    
+    tracking_vars.out_tp_file = string_format("%s/%s_TotalPayoff_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    
+    tracking_vars.out_inter_file = string_format("%s/%s_TotalInteractions_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    
+    tracking_vars.out_substrate = string_format("%s/%s_Substrate_%s_%d_%d.csv",outputFolder.c_str(),game_in.c_str(),key.c_str(), this_seed, ruggednessk);
+    
+    
+    
+    bool outputs_exist = file_exists(tracking_vars.out_network_file) && file_exists(tracking_vars.out_stats_file) && file_exists(tracking_vars.out_p1strat_file) && file_exists(tracking_vars.out_p2strat_file) && file_exists(tracking_vars.out_innov_scores);
+    #ifdef USE_MPI
+        // Process 0 writes the output, so its view decides
+        outputs_exist = broadcastFlag(outputs_exist);
+    #endif
+    
+    if(outputs_exist){
+        return std::unique_ptr<SimRun>();
+    }
+    // Construct a Game
+    std::string payoff_filename = string_format("%s/Payoffs/Payoffs_%s.csv",full_input_folder.c_str(),key.c_str());
+    
+    run->game.reset(new Game(payoff_filename, game_in.c_str(), base_in, coupling_effect));
+    
+    //Construct a network of Agents
+    //Network net("netfile.csv");
+    run->net_pop = std::stoi(these_inputs.at(1));
+    
+    // Substrate graph, random ones drawn from the run's own stream
+    MersenneRNG substrate_rng;
+    substrate_rng.eng.seed(run_stream_seed(this_seed, streams_in + "/Substrate", base_seed + seed_ind));
+    run->substrate = makeSubstrate(substrate_in, run->net_pop, full_input_folder, substrate_rng.rng);
+    
+    run->net.reset(new Network(run->net_pop,strat_file,run->game->getNumStrats(),stratlearningspeed_in, netlearningspeed_in, stratdiscount_in, netdiscount_in, strattremble_in,nettremble_in, stratsymmetric_in, netsymmetric_in, score_copy_prob, copy_error, explore_prob, run->substrate));
+    //}else{
+    //    std::string net_file = these_inputs.at(1);
+    //    net = Network(net_file, strat_file, run->game->getNumStrats(), stratlearningspeed_in, netlearningspeed_in, stratdiscount_in, netdiscount_in, strattremble_in,nettremble_in, stratsymmetric_in, netsymmetric_in, score_copy_prob, copy_error, explore_prob);
+    //} 
+    
+    tracking_vars.init_Trackers(run->net->getPop(), run->net->getPopulation().num_strats, run->substrate);
+    tracking_vars.max_time = tmax_in;
+    tracking_vars.current_seed = this_seed;
+    tracking_vars.stream_seed = run_stream_seed(this_seed, streams_in, base_seed + seed_ind);
+    tracking_vars.shuffle_rng.eng.seed(tracking_vars.stream_seed);
+    tracking_vars.run_threads = run_threads;
+    run->rank_model = rank_model;
+    
+    return run;
+}
+
+// Write a finished run's trackers to its output files
+void write_outputs(SimRun &run){
+    #ifdef USE_MPI
+        // Only process 0 holds the gathered trackers
+        if(processRank() != 0){
+            return;
+        }
+    #endif
+    
+    SimTracking &tracking_vars = run.tracking_vars;
+    const Substrate &substrate = run.substrate;
+    int net_pop = run.net_pop;
+    RankModel rank_model = run.rank_model;
+    
+    // Output tracking data
+    /////////////////////////////////////////////
+    std::ofstream net_out(tracking_vars.out_network_file.c_str());
+                
+    net_out << std::setprecision(4);
+
+    for(size_t time_i = 0; time_i < tracking_vars.network_weights_t.size(); time_i++){
+        comma_seperated(net_out, tracking_vars.network_weights_t.at(time_i).begin(), tracking_vars.network_weights_t.at(time_i).end()) << std::endl;
+    }
+    
+    // Each agent's substrate neighbors, in the order of its entries in the Weights rows
+    if(!substrate.complete()){
+        std::ofstream substrate_out(tracking_vars.out_substrate.c_str());
+        
+        for(int agent = 0; agent < net_pop; agent++){
+            comma_seperated(substrate_out, substrate.neighbors.begin() + substrate.offsets[agent], substrate.neighbors.begin() + substrate.offsets[agent + 1]) << std::endl;
+        }
+    }
+    
+    if(rank_model == RANK_DYNAMIC){
+        std::ofstream net_std_out(tracking_vars.out_net_stds.c_str());
+        
+        net_std_out << std::setprecision(4);
+        
+        for(size_t time_i = 0; time_i < tracking_vars.network_stds_t.size(); time_i++){
+            comma_seperated(net_std_out, tracking_vars.network_stds_t.at(time_i).begin(), tracking_vars.network_stds_t.at(time_i).end()) << std::endl;
+        }
+    }
+    
+
+    std::ofstream p1_strat_out(tracking_vars.out_p1strat_file.c_str());
+    
+    p1_strat_out << std::setprecision(3);
+    
+    for(size_t time_i = 0; time_i < tracking_vars.player_strategies_p1_t.size(); time_i++){
+        comma_seperated(p1_strat_out, tracking_vars.player_strategies_p1_t.at(time_i).begin(), tracking_vars.player_strategies_p1_t.at(time_i).end()) << std::endl;
+    }
+    
+    std::ofstream p2_strat_out(tracking_vars.out_p2strat_file.c_str());
+    
+    p2_strat_out << std::setprecision(3);
+    
+    for(size_t time_i = 0; time_i < tracking_vars.player_strategies_p2_t.size(); time_i++){
+        comma_seperated(p2_strat_out, tracking_vars.player_strategies_p2_t.at(time_i).begin(), tracking_vars.player_strategies_p2_t.at(time_i).end()) << std::endl;
+    }
+    
+    std::ofstream scores_out(tracking_vars.out_innov_scores.c_str());
+    
+    scores_out << std::setprecision(8);
+    
+    for(size_t time_i = 0; time_i < tracking_vars.innovation_scores_t.size(); time_i++){
+        comma_seperated(scores_out, tracking_vars.innovation_scores_t.at(time_i).begin(), tracking_vars.innovation_scores_t.at(time_i).end()) << std::endl;
+    }
+    
+    std::ofstream stats_out(tracking_vars.out_stats_file.c_str());
+    
+    stats_out << std::setprecision(3);
+    
+    for(size_t time_i = 0; time_i < tracking_vars.prop_interactions_t.size(); time_i++){
+        comma_seperated(stats_out, tracking_vars.prop_interactions_t.at(time_i).begin(), tracking_vars.prop_interactions_t.at(time_i).end()) << std::endl;
+    }
+    
+    // Rank trackers are only kept for dynamic ranks
+    if(rank_model == RANK_DYNAMIC){
+        std::ofstream fs_out(tracking_vars.out_full_strats.c_str());
+        
+        fs_out << std::fixed;
+        fs_out << std::setprecision(3);
+        
+        for(size_t time_i = 0; time_i < tracking_vars.full_strats_t.size(); time_i++){
+            comma_seperated(fs_out, tracking_vars.full_strats_t.at(time_i).begin(), tracking_vars.full_strats_t.at(time_i).end()) << std::endl;
+        }
+        
+        std::ofstream inscore_out(tracking_vars.out_inscore.c_str());
+        
+        inscore_out << std::setprecision(3);
+        
+        for(size_t time_i = 0; time_i < tracking_vars.innov_score_t.size(); time_i++){
+            comma_seperated(inscore_out, tracking_vars.innov_score_t.at(time_i).begin(), tracking_vars.innov_score_t.at(time_i).end()) << std::endl;
+        }
+    }
+    
+    std::ofstream tp_out(tracking_vars.out_tp_file.c_str());
+    
+    tp_out << std::setprecision(9);
+    
+    
+    for(size_t time_i = 0; time_i < tracking_vars.total_payoffs_t.size(); time_i++){
+        comma_seperated(tp_out, tracking_vars.total_payoffs_t.at(time_i).begin(), tracking_vars.total_payoffs_t.at(time_i).end()) << std::endl;
+    }
+    
+    std::ofstream inter_out(tracking_vars.out_inter_file.c_str());
+                    
+    
+    for(size_t time_i = 0; time_i < tracking_vars.all_interactions_t.size(); time_i++){
+        comma_seperated(inter_out, tracking_vars.all_interactions_t.at(time_i).begin(), tracking_vars.all_interactions_t.at(time_i).end()) << std::endl;
+    }
+    
+    /*
+    
+    std::ofstream locs_out(tracking_vars.out_innov_locs.c_str());
+    
+    for(size_t time_i = 0; time_i < tracking_vars.innovation_locations_t.size(); time_i++){
+        comma_seperated(locs_out, tracking_vars.innovation_locations_t.at(time_i).begin(), tracking_vars.innovation_locations_t.at(time_i).end()) << std::endl;
+    }
+
+    std::ofstream partners_out(tracking_vars.out_partners.c_str());
+    
+    for(size_t time_i = 0; time_i <tracking_vars.player_partners_t.size(); time_i++){
+        comma_seperated(partners_out, tracking_vars.player_partners_t.at(time_i).begin(), tracking_vars.player_partners_t.at(time_i).end()) << std::endl;
+    }
+    
+    std::ofstream p1_payoffs_out(tracking_vars.out_p1_payoffs.c_str());
+    
+    p1_payoffs_out << std::setprecision(3);
+    
+    for(size_t time_i = 0; time_i <tracking_vars.player_p1_payoffs_t.size(); time_i++){
+        comma_seperated(p1_payoffs_out, tracking_vars.player_p1_payoffs_t.at(time_i).begin(), tracking_vars.player_p1_payoffs_t.at(time_i).end()) << std::endl;
+    }
+    
+    std::ofstream p2_payoffs_out(tracking_vars.out_p2_payoffs.c_str());
+    
+    p2_payoffs_out << std::setprecision(3);
+    
+    for(size_t time_i = 0; time_i <tracking_vars.player_p2_payoffs_t.size(); time_i++){
+        comma_seperated(p2_payoffs_out, tracking_vars.player_p2_payoffs_t.at(time_i).begin(), tracking_vars.player_p2_payoffs_t.at(time_i).end()) << std::endl;
+    }
+     */
+    //////////////////////////////////////////// End output
+}
+
+// Run a group of seeds of one key, in lockstep when built with ENSEMBLE and the key allows it
+void run_group(std::vector<std::unique_ptr<SimRun>> &runs){
+    #ifdef ENSEMBLE
+        if(runs.size() > 1 && ensembleSupports(*runs[0]->net)){
+            std::vector<EnsembleMember> members;
+            for(size_t run_ind = 0; run_ind < runs.size(); run_ind++){
+                SimRun &run = *runs[run_ind];
+                members.push_back(EnsembleMember{&run.rng, &run.nrng, &run.tracking_vars, run.net.get()});
+            }
+            run_ensemble(*runs[0]->game, members, runs[0]->rank_model);
+            return;
+        }
+    #endif
+    
+    for(size_t run_ind = 0; run_ind < runs.size(); run_ind++){
+        SimRun &run = *runs[run_ind];
+        
+        // Run single simulation
+        run_model(run.rng, run.nrng, *run.game, run.tracking_vars, *run.net, run.rank_model);
+    }
+}
+
+// Pick the compiled timestep for this run's rank model and coupling function
+void run_model(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, RankModel rank_model){
+    #ifdef TAU_LEAP
+        // Approximate leaps of several timesteps instead
+        run_tau_leap(rng, nrng, g, tracking_vars, net, rank_model);
+        return;
+    #endif
+    #ifdef MEAN_FIELD
+        // Integrate the expected dynamics instead
+        run_mean_field(rng, nrng, g, tracking_vars, net, rank_model);
+        return;
+    #endif
+    dispatch_model<CoupledModel>(rank_model, g, rng, nrng, g, tracking_vars, net);
+}
+
+// Pick the timestep kernel for this run's learning configuration
+template<class Rank, class Coupling>
+void CoupledModel<Rank, Coupling>::run(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net){
+    LearningParams params(net.GetAgent(0));
+    
+    if(!params.net_learn){
+        // Network weights never change (NLS-0): sample from precomputed cumulative rows
+        net.getPopulation().freezeNetwork();
+        
+        if(params.strat_sym){
+            run_kernel<Rank, Coupling, false, false, true>(rng, nrng, g, tracking_vars, net);
+        }else{
+            run_kernel<Rank, Coupling, false, false, false>(rng, nrng, g, tracking_vars, net);
+        }
+    }else if(params.net_sym){
+        if(params.strat_sym){
+            run_kernel<Rank, Coupling, true, true, true>(rng, nrng, g, tracking_vars, net);
+        }else{
+            run_kernel<Rank, Coupling, true, true, false>(rng, nrng, g, tracking_vars, net);
+        }
+    }else{
+        if(params.strat_sym){
+            run_kernel<Rank, Coupling, true, false, true>(rng, nrng, g, tracking_vars, net);
+        }else{
+            run_kernel<Rank, Coupling, true, false, false>(rng, nrng, g, tracking_vars, net);
+        }
+    }
+}
+
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_kernel(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net){
+    //std::vector<double> past_payoffs_p1(pop,0.0); // Track visitor payoffs
+    //std::vector<double> past_payoffs_p2(pop*2,0.0); // Track host payoffs and how many times a host got visited
+    
+    // Initialize node strength
+    /*
+    std::vector<double> node_strength(pop, 0.0);;
+    
+    long int total_p1 = 0;
+    long int total_p2 = 0;
+    
+    for(int i = 0; i < pop; i++)
+    {
+        for(int k = 0; k < num_strats_p1; k++){
+            p1_strategy_t.push_back(p1_strategy.at(i*num_strats_p1 + k));
+        }
+        for(int k = 0; k < num_strats_p2; k++){
+            p2_strategy_t.push_back(p2_strategy.at(i*num_strats_p2 + k));
+        }
+    }
+    
+    player1_s1_t.push_back(total_p1);
+    player2_s1_t.push_back(total_p2);
+    
+    
+    adjacency_weights_t.insert(adjacency_weights_t.end(), adjacency_weights.begin(), adjacency_weights.end());
+    
+    //std::vector<float> adjacency_weights_new = adjacency_weights;
+    
+    std::vector<double> p1_strategy_new = p1_strategy;
+    std::vector<double> p2_strategy_new = p2_strategy;
+     
+     */
+    
+    // Initialize agent sequence (to be randomized each round 
+    tracking_vars.initTrackLocation<Rank>(net, rng, nrng);
+    
+    // Coupling transforms of the initial scores (refreshed as scores are committed under dynamic ranks)
+    Population &population = net.getPopulation();
+    population.bonus_cache.setTransform(&Coupling::scoreKey, population.cur_score);
+    
+    // Shuffled agent order, reused every timestep
+    std::vector<int> agent_seq(net.agent_seq);
+    
+    // Batched timestep, always used when the run is split across threads or processes
+    bool batched = tracking_vars.run_threads > 1;
+    #if defined(BATCHED_TIMESTEP) || defined(USE_MPI)
+        batched = true;
+    #endif
+    InteractionBatch batch;
+    if(batched){
+        batch.init(net.getPop(), net.getPopulation().num_strats);
+    }
+    
+    #ifdef ALLOC_CHECK
+        int alloc_steps = 0;
+        int untracked_steps = 0;
+        long untracked_allocs = 0;
+    #endif
+    
+    // Run simulation for max_time timesteps 
+    for (int t = 1; t < tracking_vars.max_time+1; t++)
+    {
+        // Update agent location at eac, h time step
+        //std::fill(past_payoffs_p1.begin(),past_payoffs_p1.end(),0.0);
+        //std::fill(past_payoffs_p2.begin(),past_payoffs_p2.end(),0.0);
+        
+        #ifdef ALLOC_CHECK
+            long allocs_before = alloc_count.load(std::memory_order_relaxed);
+        #endif
+        
+        // Run simulation for one time step, loop through all agents once
+        if(batched){
+            run_batched_timestep<Rank, Coupling, NetLearn, NetSym, StratSym>(rng, nrng, g, tracking_vars, net, t, agent_seq, batch);
+        }else{
+            run_timestep<Rank, Coupling, NetLearn, NetSym, StratSym>(rng, nrng, g, tracking_vars, net, t, agent_seq);
+        }
+        
+        #ifdef ALLOC_CHECK
+            if(!tracking_vars.isRecorded<Rank>(t)){
+                untracked_steps++;
+                long allocs = alloc_count.load(std::memory_order_relaxed) - allocs_before;
+                if(allocs != 0){
+                    alloc_steps++;
+                    untracked_allocs += allocs;
+                }
+            }
+        #endif
+    }
+    
+    #ifdef ALLOC_CHECK
+        printf("Allocation check (seed %d): %ld allocations in %d of %d untracked timesteps\n", tracking_vars.current_seed, untracked_allocs, alloc_steps, untracked_steps);
+        if(untracked_allocs > 0){
+            alloc_check_failed = true;
+        }
+    #endif
+        
+}
+
+
+// Random streams for one visitor's interaction in timestep t. By default all four are
+// the run's rng; with COUNTER_RNG each is its own counter stream, so the draws do not
+// depend on how many numbers other interactions used.
+#ifdef COUNTER_RNG
+struct InteractionStreams{
+    CounterStream partner;
+    CounterStream visit;
+    CounterStream host;
+    CounterStream coupling;
+    
+    InteractionStreams(UGenerator &rng, uint32_t seed, int t, int agent) : partner(seed, t, agent, DRAW_PARTNER), visit(seed, t, agent, DRAW_VISIT_STRATEGY), host(seed, t, agent, DRAW_HOST_STRATEGY), coupling(seed, t, agent, DRAW_COUPLING) {}
+};
+#else
+struct InteractionStreams{
+    UGenerator &partner;
+    UGenerator &visit;
+    UGenerator &host;
+    UGenerator &coupling;
+    
+    InteractionStreams(UGenerator &rng, uint32_t seed, int t, int agent) : partner(rng), visit(rng), host(rng), coupling(rng) {}
+};
+#endif
+
+// Reset agent_seq to the initial order and shuffle it for timestep t (never with the
+// global rand(), which is shared by every simulation running in the process)
+void shuffle_agents(SimTracking &tracking_vars, Network &net, int t, std::vector<int> &agent_seq){
+    std::copy(net.agent_seq.begin(), net.agent_seq.end(), agent_seq.begin());
+    #ifdef COUNTER_RNG
+        CounterStream shuffle_rng(tracking_vars.stream_seed, t, 0, DRAW_SHUFFLE);
+    #else
+        UGenerator &shuffle_rng = tracking_vars.shuffle_rng.rng;
+    #endif
+    std::random_shuffle(agent_seq.begin(), agent_seq.end(), [&shuffle_rng](int n){ return (int) (shuffle_rng() * n); });
+}
+
+// Discount the strategies about to be reinforced (visitor plays role 0, host role 1)
+template<class Rank>
+inline void discount_strategies(Agent &currentAgent, Agent &friendAgent){
+    currentAgent.discountStrategy(0);
+    friendAgent.discountStrategy(1);
+    if(Rank::discount_idle_role){
+        currentAgent.discountStrategy(1);
+        friendAgent.discountStrategy(0);
+    }
+}
+
+// Reinforce network and strategy weights with the payoffs of one interaction
+template<class Rank, bool NetLearn, bool NetSym, bool StratSym>
+inline void add_payoffs(Agent &currentAgent, Agent &friendAgent){
+    /*
+     Update network weights
+     */
+    
+    // Without network learning the discount is 0 and payoffs add 0, so the network is left alone
+    if(NetLearn){
+        currentAgent.addNetworkPayoff();
+        
+        if(NetSym) // This mean that agents partner updates their network weights as well
+        {
+            friendAgent.discountNeighbors();
+            friendAgent.addNetworkPayoff();
+            
+        }
+    }
+     
+    /*
+     Update Strategy of visitor and host
+     */
+    
+    currentAgent.addStrategyPayoff<Rank>(0);
+    friendAgent.addStrategyPayoff<Rank>(1);
+
+    
+    if(StratSym){  // If strategy is symmetric, agents are forced to have the same host and visitor strategies
+        
+        // Discount if updating
+        currentAgent.discountStrategy(1);
+        friendAgent.discountStrategy(0);
+        
+        // Update values
+        currentAgent.addStrategyPayoff<Rank>(1);
+        friendAgent.addStrategyPayoff<Rank>(0);
+        
+    }
+}
+
+// Commit the step's weights, recording tracker output on tracked steps
+template<class Rank>
+void end_timestep(UGenerator &rng, NGenerator &nrng, SimTracking &tracking_vars, Network &net, int t){
+    // Steps that record nothing only need the commit
+    if(tracking_vars.isRecorded<Rank>(t)){
+        tracking_vars.updateData<Rank>(net,rng,nrng,t);
+    }else{
+        Population &population = net.getPopulation();
+        
+        // Each agent commits only its own rows (held here, if the run is distributed)
+        #ifdef _OPENMP
+            int run_threads = tracking_vars.run_threads;
+            #pragma omp parallel for num_threads(run_threads) if(run_threads > 1)
+        #endif
+        for(int update_flag = population.row_begin; update_flag < population.row_end; update_flag++){
+            Agent &curAgent = net.GetAgent(update_flag);
+            curAgent.updateAgent();
+            Rank::commitScore(population, update_flag);
+            alloc_check_probe();
+        }
+        
+        #ifdef USE_MPI
+            syncCommitted(population);
+        #endif
+    }
+}
+
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_timestep(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, int t, std::vector<int> &agent_seq){
+    
+    // Shuffle agents in random order (updating is synchronous anyways so this only serves as another layer of randomness)
+    // Each step shuffles the initial order, agent_seq is only scratch space
+
+    shuffle_agents(tracking_vars, net, t, agent_seq);
+        
+    //////////////////////////////////////////
+    
+    int agent;
+    
+
+    // Loop through agents, random order
+    for(int agent_num = 0; agent_num < net.getPop(); agent_num++)
+    {        
+        
+        agent = agent_seq.at(agent_num); // Current agent (shuffled order)
+            
+        // Get the current visitor agent
+        Agent &currentAgent = net.GetAgent(agent);
+        InteractionStreams streams(rng, tracking_vars.stream_seed, t, agent);
+                
+         // Choose interaction partner according to network weights (random neighbor drawn from agent_seq without self)
+        int friend_ind;
+        if(NetLearn){
+            friend_ind = currentAgent.chooseFriend(streams.partner,agent_seq,agent_num);
+        }else{
+            friend_ind = currentAgent.chooseFixedFriend(streams.partner,agent_seq,agent_num);
+        }
+        
+        // Set friend agent
+        Agent &friendAgent = net.GetAgent(friend_ind);
+        friendAgent.setCurrentFriend(agent);
+        
+        //printf("Agent: %d\n", agent);
+        //printf("Friend: %d\n", friend_ind);
+        
+        
+        //Draw random numbers to determine strategy for host and visitor
+        currentAgent.chooseStrategy(streams.visit, 0);
+        friendAgent.chooseStrategy(streams.host, 1);
+        
+        discount_strategies<Rank>(currentAgent, friendAgent);
+
+        //printf("Player 1 Strategy: %d, Player 2 Strategy: %d\n",currentAgentStrategy,friendAgentStrategy);
+        
+        // See above for payoff matrix explanation: 0x0 is index 0, 0x1 is index 1, 1x0 index 2, 1x1 index 3
+        
+        /*
+        if(p1_strat_ind == 0)
+        {
+            total_p1 += 1;
+        }
+        if(p2_strat_ind == 0)
+        {
+            total_p2 += 1;
+        }
+         */
+        //printf("Payoff index: %d\n", payoff_index);
+        
+        /*
+         Interact
+         */
+        g.play<Coupling>(streams.coupling,currentAgent, friendAgent);
+        
+        /*
+         Update network weights
+         */
+        add_payoffs<Rank, NetLearn, NetSym, StratSym>(currentAgent, friendAgent);
+        
+    }
+    
+    end_timestep<Rank>(rng, nrng, tracking_vars, net, t);
+        
+        /*
+        for (auto k: net.GetAgent(update_flag).getStrats(0))
+            std::cout << k << ' ';
+        
+        printf("\n");
+        for (auto k: net.GetAgent(update_flag).getStrats(1))
+            std::cout << k << ' ';
+         
+         */
+        
+    
+    // Update current adjacency weights and strategy weights to use for next time step
+    /*
+    adjacency_weights = adjacency_weights_new;
+    p1_strategy = p1_strategy_new;
+    p2_strategy = p2_strategy_new;
+     
+     */
+}
+
+// One agent's share of interaction i of the batch, as visitor or as host. Touches only
+// that agent's weights, strategies and scores, in the order run_timestep applies them.
+template<class Rank, bool NetLearn, bool NetSym, bool StratSym>
+inline void update_visitor(Agent &currentAgent, InteractionBatch &batch, int i){
+    currentAgent.setCurrentFriend(batch.host[i]);
+    currentAgent.setCurrentStrategy(batch.visit_strategy[i]);
+    
+    if(NetLearn){
+        currentAgent.discountNeighbors();
+    }
+    currentAgent.discountStrategy(0);
+    if(Rank::discount_idle_role){
+        currentAgent.discountStrategy(1);
+    }
+    
+    currentAgent.updateInteractions(batch.num_strats * batch.visit_strategy[i] + batch.host_strategy[i]);
+    currentAgent.setCurrentPayoff(batch.visit_payoff[i]);
+    currentAgent.recordInteraction(batch.visit_payoff[i], batch.host_payoff[i]);
+    
+    if(NetLearn){
+        currentAgent.addNetworkPayoff();
+    }
+    currentAgent.addStrategyPayoff<Rank>(0);
+    if(StratSym){
+        currentAgent.discountStrategy(1);
+        currentAgent.addStrategyPayoff<Rank>(1);
+    }
+}
+
+template<class Rank, bool NetLearn, bool NetSym, bool StratSym>
+inline void update_host(Agent &friendAgent, InteractionBatch &batch, int i, int visitor){
+    friendAgent.setCurrentFriend(visitor);
+    friendAgent.setCurrentStrategy(batch.host_strategy[i]);
+    
+    friendAgent.discountStrategy(1);
+    if(Rank::discount_idle_role){
+        friendAgent.discountStrategy(0);
+    }
+    
+    friendAgent.updateInteractions(batch.num_strats * batch.visit_strategy[i] + batch.host_strategy[i]);
+    friendAgent.setCurrentPayoff(batch.host_payoff[i]);
+    
+    if(NetLearn && NetSym){
+        friendAgent.discountNeighbors();
+        friendAgent.addNetworkPayoff();
+    }
+    friendAgent.addStrategyPayoff<Rank>(1);
+    if(StratSym){
+        friendAgent.discountStrategy(0);
+        friendAgent.addStrategyPayoff<Rank>(0);
+    }
+}
+
+// Same step as run_timestep in three phases: draw every partner and strategy, evaluate
+// all payoffs, then apply the learning updates. Draws only read committed (cur) state
+// and updates only write new state, so the phases can be split without changing
+// results; rng draws keep their order. With COUNTER_RNG the draws of different agents
+// are independent and the draw phase is split across threads too.
+// With run_threads > 1 the payoff and update phases and the commit are split across
+// threads. Updates are applied per agent (its interactions in shuffled order), so no
+// two threads write the same agent and results do not depend on the thread count.
+// A distributed run (USE_MPI) draws and updates only the agents held by this process,
+// exchanging the host sides between the payoff and update phases.
+template<class Rank, class Coupling, bool NetLearn, bool NetSym, bool StratSym>
+void run_batched_timestep(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, int t, std::vector<int> &agent_seq, InteractionBatch &batch){
+    
+    shuffle_agents(tracking_vars, net, t, agent_seq);
+    
+    int pop = net.getPop();
+    #ifdef _OPENMP
+        int run_threads = tracking_vars.run_threads;
+    #endif
+    Population &population = net.getPopulation();
+    
+    // Draw phase (serial on the one rng stream; strategies are drawn without being
+    // set, since a host can be drawn by several visitors)
+    #if defined(_OPENMP) && defined(COUNTER_RNG)
+        #pragma omp parallel for num_threads(run_threads) if(run_threads > 1)
+    #endif
+    for(int agent_num = 0; agent_num < pop; agent_num++){
+        #ifdef USE_MPI
+            if(!population.holdsRow(agent_seq[agent_num])){
+                continue;
+            }
+        #endif
+        Agent &currentAgent = net.GetAgent(agent_seq[agent_num]);
+        InteractionStreams streams(rng, tracking_vars.stream_seed, t, agent_seq[agent_num]);
+        
+        int friend_ind = currentAgent.chooseFixedFriend(streams.partner,agent_seq,agent_num);
+        Agent &friendAgent = net.GetAgent(friend_ind);
+        
+        batch.host[agent_num] = friend_ind;
+        batch.visit_strategy[agent_num] = currentAgent.drawStrategy(streams.visit, 0);
+        batch.host_strategy[agent_num] = friendAgent.drawStrategy(streams.host, 1);
+        batch.visit_score[agent_num] = currentAgent.getScore();
+        batch.host_score[agent_num] = friendAgent.getScore();
+        batch.visit_key[agent_num] = currentAgent.getScoreKey();
+        batch.host_key[agent_num] = friendAgent.getScoreKey();
+        if(Coupling::uses_draw){
+            batch.draw[agent_num] = streams.coupling();
+        }
+    }
+    
+    #ifdef _OPENMP
+        #pragma omp parallel num_threads(run_threads) if(run_threads > 1)
+    #endif
+    {
+        // Payoff phase
+        int thread_num = omp_get_thread_num();
+        int num_threads = omp_get_num_threads();
+        g.playBatch<Coupling>(batch, (int) ((long) pop * thread_num / num_threads), (int) ((long) pop * (thread_num + 1) / num_threads));
+        
+        #ifdef _OPENMP
+            #pragma omp barrier
+        #endif
+        
+        #ifdef _OPENMP
+            #pragma omp master
+        #endif
+        {
+            #ifdef USE_MPI
+                exchangeHostEvents(population, batch, agent_seq);
+            #endif
+            batch.indexEvents(agent_seq);
+        }
+        #ifdef _OPENMP
+            #pragma omp barrier
+        #endif
+        
+        // Update phase
+        #ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 16)
+        #endif
+        for(int agent = population.row_begin; agent < population.row_end; agent++){
+            Agent &curAgent = net.GetAgent(agent);
+            for(int k = batch.event_start[agent]; k < batch.event_start[agent + 1]; k++){
+                int i = batch.events[k] / 2;
+                if(batch.events[k] % 2 == 0){
+                    update_visitor<Rank, NetLearn, NetSym, StratSym>(curAgent, batch, i);
+                }else{
+                    update_host<Rank, NetLearn, NetSym, StratSym>(curAgent, batch, i, agent_seq[i]);
+                }
+            }
+        }
+    }
+    
+    end_timestep<Rank>(rng, nrng, tracking_vars, net, t);
+}
+
+// Seed for a run's own streams, from its seed value, key and seed index (FNV-1a), so a
+// run draws the same numbers whichever thread runs it and whatever ran before
+uint32_t run_stream_seed(int seed, const std::string &key, int seed_ind){
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](uint32_t byte){ hash = (hash ^ byte) * 16777619u; };
+    for(int b = 0; b < 4; b++){
+        mix(((uint32_t) seed >> (8 * b)) & 0xFF);
+    }
+    for(char c : key){
+        mix((unsigned char) c);
+    }
+    for(int b = 0; b < 4; b++){
+        mix(((uint32_t) seed_ind >> (8 * b)) & 0xFF);
+    }
+    return hash;
+}
+
+bool is_number(const std::string& s)
+{
+    return !s.empty() && std::find_if(s.begin(), s.end(), [](char c) { return !std::isdigit(c); }) == s.end();
+}
+bool file_exists (const std::string& name) {
+    struct stat buffer;   
+    return (stat (name.c_str(), &buffer) == 0); 
+}
+
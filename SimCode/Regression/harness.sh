@@ -0,0 +1,51 @@
+# Shared by the check scripts in SimCode: builds binaries and runs them on the inputs in
+# this folder, each in its own scratch folder (the binary reads its seeds from
+# ../Helpers/ESD_Seeds_All_Ordered.csv, so the scratch folder holds a copy of Seeds.csv).
+# CXX and CXXFLAGS (e.g. the Boost -I and -L flags) are passed to the compiler.
+
+regression_dir=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+sim_dir=$(dirname "$regression_dir")
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+mkdir -p "$work/Helpers" "$work/bin"
+cp "$regression_dir/Seeds.csv" "$work/Helpers/ESD_Seeds_All_Ordered.csv"
+
+# build NAME FLAGS...: compile the simulation code with FLAGS into $work/bin/NAME, in the
+# background (wait_builds waits for them all)
+build(){
+    local name=$1
+    shift
+    echo "Building $name"
+    ${CXX:-g++} -O3 -fopenmp "$@" "$sim_dir"/*.cpp -std=c++11 $CXXFLAGS -o "$work/bin/$name" 2> "$work/bin/$name.log" &
+}
+
+wait_builds(){
+    local name
+    wait
+    for name in $(ls "$work/bin" | grep '\.log$' | sed 's/\.log$//'); do
+        if [ ! -x "$work/bin/$name" ]; then
+            cat "$work/bin/$name.log"
+            echo "FAILED  to build $name"
+            exit 1
+        fi
+    done
+}
+
+# run_status NAME BINARY INPUT THREADS RUN_THREADS SEEDS: run every key of HDInnov_Input/Input_HDInnov_INPUT
+# over the first SEEDS seeds with $work/bin/BINARY, writing HDInnov_Output_Data under $work/NAME and
+# its output to $work/NAME.log, and return the binary's exit status
+run_status(){
+    mkdir -p "$work/$1"
+    ln -s "$regression_dir/HDInnov_Input" "$work/$1/HDInnov_Input"
+    (cd "$work/$1" && "$work/bin/$2" "$3" 0 "$4" "$6" 0 0 7 "$5" > "$work/$1.log" 2>&1)
+}
+
+# run: run_status, stopping the script if the binary fails
+run(){
+    if ! run_status "$@"; then
+        cat "$work/$1.log"
+        echo "FAILED  to run $1"
+        exit 1
+    fi
+}
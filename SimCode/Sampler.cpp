@@ -0,0 +1,273 @@
+/* The PartnerSampler class Implementations (Sampler.cpp) */
+#include "Network.h" // user-defined header in the same directory
+#include <numeric>
+#include <algorithm>
+
+// Relative weights are rebuilt from the committed row once their scale drops below this
+#define SAMPLER_MIN_SCALE 1e-64
+
+std::unique_ptr<PartnerSampler> makePartnerSampler(Population &population, bool frozen){
+#ifdef SPARSE_NETWORK
+    // Sparse rows are O(k) to scan, frozen or not
+    return std::unique_ptr<PartnerSampler>(new SparseSampler(population));
+#else
+    if(!population.substrate.complete()){
+        return std::unique_ptr<PartnerSampler>(new SubstrateSampler(population));
+    }
+    if(frozen){
+        return std::unique_ptr<PartnerSampler>(new FixedSampler(population));
+    }
+    if(population.pop >= SAMPLER_TREE_MIN_POP){
+        return std::unique_ptr<PartnerSampler>(new TreeSampler(population));
+    }
+    return std::unique_ptr<PartnerSampler>(new ScanSampler(population));
+#endif
+}
+
+// Scan sampler
+ScanSampler::ScanSampler(Population &population) : population(population) {}
+
+void ScanSampler::build(int agent){
+    // Reads the committed row directly, nothing to keep up to date
+}
+
+int ScanSampler::sample(int agent, double draw){
+    int pop = population.pop;
+    const weight_t *cur_friends = population.curFriends(agent);
+
+    // Running sums are recomputed rather than kept in scratch space (same values as a partial_sum)
+    double interaction_random_draw = draw * std::accumulate(cur_friends, cur_friends + pop, 0.0);
+
+    // First neighbor whose cumulative weight reaches the draw (sums are nondecreasing).
+    // The loop stays scalar on purpose: a SIMD scan would add the weights in a different
+    // order, and the rounding of those sums decides which partner a draw near a boundary
+    // picks, so only the sequential partial_sum order keeps runs reproducible and
+    // identical to the original code.  Branchless, it is cheap at the small populations
+    // that use it.
+    int friend_ind = 0;
+    double running_sum = 0;
+    for(int nid = 0; nid < pop; nid++){
+        running_sum += cur_friends[nid];
+        friend_ind += (running_sum < interaction_random_draw);
+    }
+
+    // Skip self
+    if(friend_ind == agent){
+        friend_ind++;
+    }
+    if(friend_ind >= pop){
+        return -1;
+    }
+    return friend_ind;
+}
+
+// Tree sampler
+TreeSampler::TreeSampler(Population &population) : population(population){
+    pop = population.pop;
+
+    top_step = 1;
+    while(top_step * 2 <= pop){
+        top_step *= 2;
+    }
+
+    // Held rows only
+    int rows = population.row_end - population.row_begin;
+    tree.assign((size_t) rows * (pop + 1), 0.0);
+    values.assign((size_t) rows * pop, 0.0);
+    scale.assign(pop, 1.0);
+}
+
+void TreeSampler::build(int agent){
+    const weight_t *cur_friends = population.curFriends(agent);
+    double *agent_tree = &tree[(size_t) (agent - population.row_begin) * (pop + 1)];
+    double *agent_values = &values[(size_t) (agent - population.row_begin) * pop];
+
+    std::copy(cur_friends, cur_friends + pop, agent_values);
+    scale[agent] = 1.0;
+
+    // Linear time Fenwick construction
+    agent_tree[0] = 0;
+    std::copy(agent_values, agent_values + pop, agent_tree + 1);
+    for(int i = 1; i <= pop; i++){
+        int parent = i + (i & -i);
+        if(parent <= pop){
+            agent_tree[parent] += agent_tree[i];
+        }
+    }
+}
+
+void TreeSampler::set(int agent, int partner, double value){
+    double *agent_tree = &tree[(size_t) (agent - population.row_begin) * (pop + 1)];
+    double &old_value = values[(size_t) (agent - population.row_begin) * pop + partner];
+    double delta = value - old_value;
+    old_value = value;
+
+    for(int i = partner + 1; i <= pop; i += i & -i){
+        agent_tree[i] += delta;
+    }
+}
+
+void TreeSampler::commit(int agent, double factor){
+    scale[agent] *= factor;
+
+    if(scale[agent] < SAMPLER_MIN_SCALE || population.rowDirty(agent)){
+        build(agent);
+        return;
+    }
+
+    // Clean entries kept their relative weight, dirty ones are read back from the committed row
+    const weight_t *cur_friends = population.curFriends(agent);
+    const int *agent_dirty = population.agentDirty(agent);
+    for(int k = 0; k < population.dirty_count[agent]; k++){
+        int partner = agent_dirty[k];
+        set(agent, partner, cur_friends[partner] / scale[agent]);
+    }
+}
+
+int TreeSampler::sample(int agent, double draw){
+    const double *agent_tree = &tree[(size_t) (agent - population.row_begin) * (pop + 1)];
+
+    double total = 0;
+    for(int i = pop; i > 0; i -= i & -i){
+        total += agent_tree[i];
+    }
+    double interaction_random_draw = draw * total;
+
+    // Binary lifting to the first neighbor whose cumulative weight reaches the draw
+    int pos = 0;
+    for(int step = top_step; step > 0; step /= 2){
+        if(pos + step <= pop && agent_tree[pos + step] < interaction_random_draw){
+            pos += step;
+            interaction_random_draw -= agent_tree[pos];
+        }
+    }
+    int friend_ind = pos;
+
+    // Skip self
+    if(friend_ind == agent){
+        friend_ind++;
+    }
+    if(friend_ind >= pop){
+        return -1;
+    }
+    return friend_ind;
+}
+
+// Fixed sampler
+FixedSampler::FixedSampler(Population &population) : population(population){
+    pop = population.pop;
+    cumulative.assign((size_t) (population.row_end - population.row_begin) * pop, 0.0);
+}
+
+void FixedSampler::build(int agent){
+    const weight_t *cur_friends = population.curFriends(agent);
+    double *agent_cumulative = &cumulative[(size_t) (agent - population.row_begin) * pop];
+
+    // Summed in double whatever the weight storage (same values as a partial_sum of doubles)
+    double running_sum = 0;
+    for(int nid = 0; nid < pop; nid++){
+        running_sum += cur_friends[nid];
+        agent_cumulative[nid] = running_sum;
+    }
+}
+
+int FixedSampler::sample(int agent, double draw){
+    const double *agent_cumulative = &cumulative[(size_t) (agent - population.row_begin) * pop];
+
+    double interaction_random_draw = draw * agent_cumulative[pop-1];
+
+    // First neighbor whose cumulative weight reaches the draw, same pick as the scan
+    int friend_ind = (int) (std::lower_bound(agent_cumulative, agent_cumulative + pop, interaction_random_draw) - agent_cumulative);
+
+    // Skip self
+    if(friend_ind == agent){
+        friend_ind++;
+    }
+    if(friend_ind >= pop){
+        return -1;
+    }
+    return friend_ind;
+}
+
+// Substrate sampler
+SubstrateSampler::SubstrateSampler(Population &population) : population(population) {}
+
+void SubstrateSampler::build(int agent){
+    // Reads the committed row directly, nothing to keep up to date
+}
+
+int SubstrateSampler::sample(int agent, double draw){
+    int degree = population.rowLength(agent);
+    const weight_t *cur_friends = population.curFriends(agent);
+    
+    double interaction_random_draw = draw * std::accumulate(cur_friends, cur_friends + degree, 0.0);
+    
+    // First edge whose cumulative weight reaches the draw, as in the scan sampler
+    int column = 0;
+    double running_sum = 0;
+    for(int k = 0; k < degree; k++){
+        running_sum += cur_friends[k];
+        column += (running_sum < interaction_random_draw);
+    }
+    if(column >= degree){
+        return -1;
+    }
+    return population.partnerAt(agent, column);
+}
+
+#ifdef SPARSE_NETWORK
+// Sparse sampler
+int SparseRow::implicitPartner(int self, int index) const{
+    // Step over the excluded partners (self merged into the ascending explicit ones) at or below the candidate
+    int candidate = index;
+    int k = 0;
+    bool self_passed = false;
+    while(true){
+        bool next_self = !self_passed && (k == count || self < partner[k]);
+        if(!next_self && k == count){
+            break;
+        }
+        int next = next_self ? self : partner[k];
+        if(next > candidate){
+            break;
+        }
+        candidate++;
+        if(next_self){
+            self_passed = true;
+        }else{
+            k++;
+        }
+    }
+    return candidate;
+}
+
+SparseSampler::SparseSampler(Population &population) : population(population) {}
+
+void SparseSampler::build(int agent){
+    // Reads the committed row directly, nothing to keep up to date
+}
+
+int SparseSampler::sample(int agent, double draw){
+    const SparseRow &row = population.curRow(agent);
+    double explicit_sum = std::accumulate(row.weight, row.weight + row.count, 0.0);
+    double interaction_random_draw = draw * (explicit_sum + row.rest);
+    
+    // Explicit partners first
+    double running_sum = 0;
+    for(int k = 0; k < row.count; k++){
+        running_sum += row.weight[k];
+        if(interaction_random_draw < running_sum){
+            return row.partner[k];
+        }
+    }
+    
+    // Then the rest mass, evenly over the implicit partners
+    int implicit = population.pop - 1 - row.count;
+    if(implicit <= 0 || !(row.rest > 0)){
+        return row.count > 0 ? row.partner[row.count - 1] : -1;
+    }
+    int index = (int) ((interaction_random_draw - explicit_sum) / row.rest * implicit);
+    index = std::min(std::max(index, 0), implicit - 1);
+    return row.implicitPartner(agent, index);
+}
+#endif
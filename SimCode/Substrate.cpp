@@ -0,0 +1,173 @@
+/* The Substrate graph builders (Substrate.cpp) */
+#include "Network.h" // user-defined header in the same directory
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <algorithm>
+#include <math.h>
+
+static void badSubstrate(const std::string &spec, const std::string &reason){
+    std::cerr << "Error: substrate " << spec << ": " << reason << "\n";
+    _Exit(1);
+}
+
+// Numeric parameter of a spec, exits if it is not a number
+static double substrateParam(const std::string &spec, const std::string &text){
+    char *end;
+    double value = strtod(text.c_str(), &end);
+    if(text.empty() || *end != '\0'){
+        badSubstrate(spec, "parameter " + text + " is not a number");
+    }
+    return value;
+}
+
+static void addEdge(std::vector<std::vector<int>> &adjacency, int a, int b){
+    adjacency[a].push_back(b);
+    adjacency[b].push_back(a);
+}
+
+// Neighbor lists sorted and deduplicated into the offsets/neighbors form
+static Substrate fromAdjacency(std::vector<std::vector<int>> &adjacency, const std::string &spec){
+    Substrate substrate;
+    substrate.offsets.push_back(0);
+    for(size_t i = 0; i < adjacency.size(); i++){
+        std::vector<int> &row = adjacency[i];
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        if(row.empty()){
+            badSubstrate(spec, "agent " + std::to_string(i) + " has no partners");
+        }
+        substrate.neighbors.insert(substrate.neighbors.end(), row.begin(), row.end());
+        substrate.offsets.push_back(substrate.neighbors.size());
+    }
+    return substrate;
+}
+
+// Each agent linked to the k nearest on either side
+static void ringEdges(std::vector<std::vector<int>> &adjacency, int pop, int k){
+    for(int m = 1; m <= k; m++){
+        for(int i = 0; i < pop; i++){
+            addEdge(adjacency, i, (i + m) % pop);
+        }
+    }
+}
+
+Substrate makeSubstrate(const std::string &spec, int pop, const std::string &input_folder, UGenerator &rng){
+    // Kind, then colon-separated parameters
+    std::vector<std::string> parts;
+    std::stringstream split(spec);
+    std::string part;
+    while(std::getline(split, part, ':')){
+        parts.push_back(part);
+    }
+    std::string kind = parts.empty() ? "" : parts.at(0);
+
+    std::vector<std::vector<int>> adjacency(pop);
+
+    if(kind == "Complete" && parts.size() == 1){
+        return Substrate();
+    }else if(kind == "Ring" && parts.size() == 2){
+        int k = (int) substrateParam(spec, parts[1]);
+        if(k < 1 || 2 * k >= pop){
+            badSubstrate(spec, "needs 1 <= k < pop/2");
+        }
+        ringEdges(adjacency, pop, k);
+    }else if(kind == "Lattice" && parts.size() <= 2){
+        // Torus, each agent linked to its 4 nearest
+        int width = parts.size() == 2 ? (int) substrateParam(spec, parts[1]) : (int) lround(sqrt(pop));
+        if(width < 3 || pop % width != 0 || pop / width < 3){
+            badSubstrate(spec, "needs pop = width x height, both at least 3");
+        }
+        int height = pop / width;
+        for(int row = 0; row < height; row++){
+            for(int col = 0; col < width; col++){
+                int i = row * width + col;
+                addEdge(adjacency, i, row * width + (col + 1) % width);
+                addEdge(adjacency, i, ((row + 1) % height) * width + col);
+            }
+        }
+    }else if(kind == "ER" && parts.size() == 2){
+        // Erdos-Renyi with the given mean degree
+        double link_prob = substrateParam(spec, parts[1]) / (pop - 1);
+        if(!(link_prob > 0 && link_prob <= 1)){
+            badSubstrate(spec, "needs 0 < mean degree <= pop - 1");
+        }
+
+        // Geometric skips over each agent's higher-numbered candidates, O(pop + edges)
+        double log_miss = log1p(-link_prob);
+        for(int i = 0; i < pop; i++){
+            double j = i;
+            while(true){
+                j += (link_prob < 1) ? 1 + floor(log(1 - rng()) / log_miss) : 1;
+                if(j >= pop){
+                    break;
+                }
+                addEdge(adjacency, i, (int) j);
+            }
+        }
+
+        // Agents left isolated get one uniformly random partner
+        for(int i = 0; i < pop; i++){
+            if(adjacency[i].empty()){
+                int j = (int) (rng() * (pop - 1));
+                if(j >= i){
+                    j++;
+                }
+                addEdge(adjacency, i, j);
+            }
+        }
+    }else if(kind == "SmallWorld" && parts.size() == 3){
+        // Watts-Strogatz: ring with k on either side, each link's far end rewired with the given probability
+        int k = (int) substrateParam(spec, parts[1]);
+        double rewire_prob = substrateParam(spec, parts[2]);
+        if(k < 1 || 2 * k >= pop || rewire_prob < 0 || rewire_prob > 1){
+            badSubstrate(spec, "needs 1 <= k < pop/2 and 0 <= rewire probability <= 1");
+        }
+        ringEdges(adjacency, pop, k);
+
+        for(int m = 1; m <= k; m++){
+            for(int i = 0; i < pop; i++){
+                int old_partner = (i + m) % pop;
+                std::vector<int> &links = adjacency[i];
+                if(rng() >= rewire_prob || (int) links.size() >= pop - 1){
+                    continue;
+                }
+                std::vector<int>::iterator old_link = std::find(links.begin(), links.end(), old_partner);
+                if(old_link == links.end()){
+                    continue; // Already rewired away from the other end
+                }
+
+                int new_partner;
+                do{
+                    new_partner = (int) (rng() * pop);
+                }while(new_partner == i || std::find(links.begin(), links.end(), new_partner) != links.end());
+
+                links.erase(old_link);
+                std::vector<int> &old_links = adjacency[old_partner];
+                old_links.erase(std::find(old_links.begin(), old_links.end(), i));
+                addEdge(adjacency, i, new_partner);
+            }
+        }
+    }else if(kind == "Edges" && parts.size() == 2){
+        // Whitespace-separated agent pairs (0-indexed), undirected, self loops ignored
+        std::string edge_path = input_folder + "/" + parts[1];
+        std::ifstream edge_stream(edge_path);
+        if(edge_stream.fail()){
+            badSubstrate(spec, "cannot read " + edge_path);
+        }
+        int a, b;
+        while(edge_stream >> a >> b){
+            if(a < 0 || a >= pop || b < 0 || b >= pop){
+                badSubstrate(spec, "edge " + std::to_string(a) + " " + std::to_string(b) + " is outside the population");
+            }
+            if(a != b){
+                addEdge(adjacency, a, b);
+            }
+        }
+    }else{
+        badSubstrate(spec, "unknown (use Complete, Ring:k, Lattice[:width], ER:mean_degree, SmallWorld:k:rewire_prob or Edges:file)");
+    }
+
+    return fromAdjacency(adjacency, spec);
+}
@@ -0,0 +1,585 @@
+/* The tau leaping engine (TauLeap.cpp), built with -DTAU_LEAP=tol */
+#ifdef TAU_LEAP
+#include "Network.h" // user-defined header in the same directory
+#include <iostream>
+#include <numeric>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+// One leap's interactions, an entry per (visitor, host, visitor strategy, host strategy)
+// that happened, with how many times. The batch holds the hosts, strategies and scores
+// for Game::playBatch and gets each entry's payoffs (for one interaction).
+struct LeapCells{
+    InteractionBatch batch;
+    std::vector<int> visitor;
+    std::vector<int> count;
+
+    void clear(){
+        visitor.clear();
+        count.clear();
+        batch.host.clear();
+        batch.visit_strategy.clear();
+        batch.host_strategy.clear();
+        batch.visit_score.clear();
+        batch.host_score.clear();
+        batch.visit_key.clear();
+        batch.host_key.clear();
+        batch.draw.clear();
+        batch.size = 0;
+    }
+
+    void add(const Population &population, int visitor, int host, int visit_strategy, int host_strategy, int count, double draw){
+        this->visitor.push_back(visitor);
+        this->count.push_back(count);
+        batch.host.push_back(host);
+        batch.visit_strategy.push_back(visit_strategy);
+        batch.host_strategy.push_back(host_strategy);
+        batch.visit_score.push_back(population.cur_score[visitor]);
+        batch.host_score.push_back(population.cur_score[host]);
+        batch.visit_key.push_back(population.bonus_cache.score_key[visitor]);
+        batch.host_key.push_back(population.bonus_cache.score_key[host]);
+        batch.draw.push_back(draw);
+        batch.size++;
+    }
+};
+
+// Per-agent totals carried between leaps
+struct LeapState{
+    std::vector<double> strat_prob; // pop x num_roles x num_strats, committed choice probabilities
+    std::vector<int> hosted; // Times hosted in the leap
+
+    // True weight totals of each network row and strategy set, kept up to date as
+    // leaps are applied, and at the start of the last leap
+    std::vector<double> net_mass; // pop
+    std::vector<double> strat_mass; // pop x num_roles
+    std::vector<double> net_start;
+    std::vector<double> strat_start;
+
+    // Payoffs added in the last leap (before discounting), to each row and each strategy
+    std::vector<double> net_added; // pop
+    std::vector<double> strat_added; // pop x num_roles x num_strats
+
+    // Largest change of any row's or strategy set's choice probabilities in the last leap
+    double drift;
+    std::vector<double> drift_sum; // pop, per row: sum over the added links of |added - probability x total added|
+    std::vector<double> drift_prob; // pop, per row: probability of the added links
+
+    // Gain of a payoff spread evenly over the leap's discounts (see leap_gain)
+    std::vector<double> net_gain;
+    std::vector<double> strat_gain;
+
+    // Scratch for one visitor's draws
+    std::vector<double> probs;
+    std::vector<int> counts;
+    std::vector<double> draws;
+    std::vector<int> partners;
+    std::vector<int> partner_counts;
+    std::vector<int> visit_split;
+    std::vector<int> host_split;
+
+    // Last visit of each agent, for the trackers
+    std::vector<int> last_cell;
+    std::vector<int> visits_seen;
+
+    void init(Population &population){
+        int pop = population.pop;
+        int roles = population.num_roles;
+        strat_prob.assign((size_t) pop * roles * population.num_strats, 0.0);
+        hosted.assign(pop, 0);
+        net_mass.assign(pop, 0.0);
+        strat_mass.assign(pop * roles, 0.0);
+        net_added.assign(pop, 0.0);
+        strat_added.assign((size_t) pop * roles * population.num_strats, 0.0);
+        drift = 0;
+        drift_sum.assign(pop, 0.0);
+        drift_prob.assign(pop, 0.0);
+        net_gain.assign(pop, 1.0);
+        strat_gain.assign(pop * roles, 1.0);
+        visit_split.assign(population.num_strats, 0);
+        host_split.assign(population.num_strats, 0);
+        last_cell.assign(pop, -1);
+        visits_seen.assign(pop, 0);
+
+        for(int agent = 0; agent < pop; agent++){
+            const weight_t *friends = population.curFriends(agent);
+            net_mass[agent] = std::accumulate(friends, friends + population.rowLength(agent), 0.0) * population.cur_weight_scale[agent];
+            for(int role = 0; role < roles; role++){
+                const weight_t *strats = population.curStrats(agent, role);
+                strat_mass[agent * roles + role] = std::accumulate(strats, strats + population.num_strats, 0.0) * population.cur_strat_scale[agent * roles + role];
+            }
+        }
+    }
+};
+
+// Binomial(n, p) by inversion of one uniform draw, O(n min(p, 1-p)) steps (leap counts
+// are at most TAU_LEAP_MAX_STEPS, so (1-p)^n stays representable)
+static int binomial_draw(int n, double p, double draw){
+    if(n <= 0 || !(p > 0)){
+        return 0;
+    }
+    if(p >= 1){
+        return n;
+    }
+    if(p > 0.5){
+        return n - binomial_draw(n, 1 - p, draw);
+    }
+
+    double odds = p / (1 - p);
+    double pmf = std::pow(1 - p, n);
+    double cdf = pmf;
+    int k = 0;
+    while(cdf < draw && k < n){
+        pmf = pmf * odds * (n - k) / (k + 1);
+        k++;
+        cdf = cdf + pmf;
+    }
+    return k;
+}
+
+// Split n trials over count categories with probabilities probs (summing to total) by
+// conditional binomials, adding them to counts. The last possible category takes what
+// is left, so rounding in the probabilities never loses a trial.
+static void multinomial_draw(UGenerator &rng, int n, const double *probs, int count, double total, int *counts){
+    int last = count - 1;
+    while(last > 0 && !(probs[last] > 0)){
+        last--;
+    }
+    for(int c = 0; c < last && n > 0; c++){
+        if(!(probs[c] > 0)){
+            continue;
+        }
+        int drawn = binomial_draw(n, probs[c] / total, rng());
+        counts[c] += drawn;
+        n -= drawn;
+        total -= probs[c];
+    }
+    counts[last] += n;
+}
+
+// Mean of the discount factors a payoff is scaled by when it lands on one of events
+// discounts (factor over all of them) with equal chance: (1 + f + ... + f^(events-1)) / events
+static double leap_gain(double factor, int events, float discount){
+    double per_event = 1 - discount;
+    if(events <= 1 || per_event >= 1){
+        return 1;
+    }
+    return (1 - factor) / (events * (1 - per_event));
+}
+
+// Last step of the leap starting at t: leap steps on, cut at the first recorded step so
+// the trackers see the same steps as an exact run
+template<class Rank>
+static int leap_end(SimTracking &tracking_vars, int t, int leap){
+    int last = std::min(t + leap - 1, tracking_vars.max_time);
+    for(int s = t; s < last; s++){
+        if(tracking_vars.isRecorded<Rank>(s)){
+            return s;
+        }
+    }
+    return last;
+}
+
+// Every visitor's steps visits of the leap, split over hosts and then over both sides'
+// strategies, from the committed weights
+template<class Coupling>
+static void draw_leap(UGenerator &rng, Population &population, const LearningParams &params, int steps, LeapState &state, LeapCells &cells){
+    int pop = population.pop;
+    int roles = population.num_roles;
+    int num_strats = population.num_strats;
+    bool complete = population.substrate.complete();
+
+    // Strategy choice probabilities: by weight, or uniform after a tremble
+    for(int agent = 0; agent < pop; agent++){
+        for(int role = 0; role < roles; role++){
+            const weight_t *strats = population.curStrats(agent, role);
+            double strat_sum = std::accumulate(strats, strats + num_strats, 0.0);
+            double *prob = &state.strat_prob[((size_t) agent * roles + role) * num_strats];
+            for(int s = 0; s < num_strats; s++){
+                double weighted = strat_sum > 0 ? strats[s] / strat_sum : 1.0 / num_strats;
+                prob[s] = params.strategy_tremble / num_strats + (1 - params.strategy_tremble) * weighted;
+            }
+        }
+    }
+
+    cells.clear();
+    for(int agent = 0; agent < pop; agent++){
+        int row_len = population.rowLength(agent);
+        int others = complete ? pop - 1 : row_len;
+        state.partners.clear();
+        state.partner_counts.clear();
+
+        if(complete && pop >= SAMPLER_TREE_MIN_POP && steps * 4 < row_len){
+            // Few visits over a long row: draw them one at a time from the sampler.
+            // Almost every visit is then its own cell, so this is no cheaper than the
+            // exact steps (sorting and the cells add to it); an aggregated draw cannot
+            // do better while the visits rarely repeat a partner.
+            for(int k = 0; k < steps; k++){
+                int partner;
+                if(rng() <= params.network_tremble){
+                    partner = (int) (rng() * others);
+                    if(partner >= agent){
+                        partner++;
+                    }
+                }else{
+                    partner = population.sampler->sample(agent, rng());
+                }
+                if(partner >= 0){
+                    state.partners.push_back(partner);
+                }
+            }
+            std::sort(state.partners.begin(), state.partners.end());
+            size_t kept = 0;
+            for(size_t k = 0; k < state.partners.size(); k++){
+                if(kept > 0 && state.partners[kept - 1] == state.partners[k]){
+                    state.partner_counts[kept - 1]++;
+                }else{
+                    state.partners[kept++] = state.partners[k];
+                    state.partner_counts.push_back(1);
+                }
+            }
+            state.partners.resize(kept);
+        }else{
+            // Split the visits over the whole row
+            const weight_t *friends = population.curFriends(agent);
+            double net_sum = std::accumulate(friends, friends + row_len, 0.0);
+            double weighted_scale = net_sum > 0 ? (1 - params.network_tremble) / net_sum : 0;
+            double uniform = params.network_tremble / others;
+            double total = uniform * others + (net_sum > 0 ? 1 - params.network_tremble : 0);
+            if(!(total > 0)){
+                continue;
+            }
+            if(steps > row_len){
+                // Many visits per link: conditional binomials, one uniform per link
+                state.probs.assign(row_len, 0.0);
+                state.counts.assign(row_len, 0);
+                for(int column = 0; column < row_len; column++){
+                    if(!(complete && column == agent)){
+                        state.probs[column] = uniform + weighted_scale * friends[column];
+                    }
+                }
+                multinomial_draw(rng, steps, state.probs.data(), row_len, total, state.counts.data());
+                for(int column = 0; column < row_len; column++){
+                    if(state.counts[column] > 0){
+                        state.partners.push_back(population.partnerAt(agent, column));
+                        state.partner_counts.push_back(state.counts[column]);
+                    }
+                }
+            }else{
+                // Fewer visits than links: sorted uniforms against one pass of the cumulative
+                // probabilities, which saves the binomial per link
+                state.draws.resize(steps);
+                for(int k = 0; k < steps; k++){
+                    state.draws[k] = rng() * total;
+                }
+                std::sort(state.draws.begin(), state.draws.end());
+                int drawn = 0;
+                int last_column = -1;
+                double running = 0;
+                for(int column = 0; column < row_len && drawn < steps; column++){
+                    if(complete && column == agent){
+                        continue;
+                    }
+                    double prob = uniform + weighted_scale * friends[column];
+                    if(!(prob > 0)){
+                        continue;
+                    }
+                    running += prob;
+                    last_column = column;
+                    int count = 0;
+                    while(drawn < steps && state.draws[drawn] < running){
+                        drawn++;
+                        count++;
+                    }
+                    if(count > 0){
+                        state.partners.push_back(population.partnerAt(agent, column));
+                        state.partner_counts.push_back(count);
+                    }
+                }
+                if(drawn < steps && last_column >= 0){
+                    // Rounding left the last draws past the final sum
+                    int partner = population.partnerAt(agent, last_column);
+                    if(!state.partners.empty() && state.partners.back() == partner){
+                        state.partner_counts.back() += steps - drawn;
+                    }else{
+                        state.partners.push_back(partner);
+                        state.partner_counts.push_back(steps - drawn);
+                    }
+                }
+            }
+        }
+
+        // Visitor's strategy (role 0) for each visit to the host, then the host's (role 1)
+        const double *visit_prob = &state.strat_prob[(size_t) agent * roles * num_strats];
+        for(size_t k = 0; k < state.partners.size(); k++){
+            int host = state.partners[k];
+            const double *host_prob = &state.strat_prob[((size_t) host * roles + 1) * num_strats];
+
+            std::fill(state.visit_split.begin(), state.visit_split.end(), 0);
+            multinomial_draw(rng, state.partner_counts[k], visit_prob, num_strats, 1.0, state.visit_split.data());
+            for(int a = 0; a < num_strats; a++){
+                if(state.visit_split[a] == 0){
+                    continue;
+                }
+                std::fill(state.host_split.begin(), state.host_split.end(), 0);
+                multinomial_draw(rng, state.visit_split[a], host_prob, num_strats, 1.0, state.host_split.data());
+                for(int b = 0; b < num_strats; b++){
+                    int count = state.host_split[b];
+                    if(count == 0){
+                        continue;
+                    }
+                    if(Coupling::uses_draw){
+                        // Each interaction takes its own coupling draw
+                        for(int i = 0; i < count; i++){
+                            cells.add(population, agent, host, a, b, 1, rng());
+                        }
+                    }else{
+                        cells.add(population, agent, host, a, b, count, 0);
+                    }
+                }
+            }
+        }
+    }
+
+    cells.batch.visit_payoff.resize(cells.batch.size);
+    cells.batch.host_payoff.resize(cells.batch.size);
+}
+
+// Add the payoff added to one link of agent's row to the row's drift
+static void add_link_drift(Population &population, LeapState &state, int agent, int partner, double added){
+    const weight_t *friends = population.curFriends(agent);
+    double prob = friends[population.columnOf(agent, partner)] * population.cur_weight_scale[agent] / state.net_start[agent];
+    state.drift_sum[agent] += std::fabs(added - prob * state.net_added[agent]);
+    state.drift_prob[agent] += prob;
+}
+
+// How far the leap moved the choice probabilities it held fixed: for each network row and
+// strategy set, the sum over its entries of |added - probability x total added|, over its
+// total weight at the start of the leap (the committed weights are still those)
+static void leap_drift(Population &population, const LearningParams &params, LeapState &state, LeapCells &cells){
+    int pop = population.pop;
+    int roles = population.num_roles;
+    int num_strats = population.num_strats;
+    state.drift = 0;
+
+    if(params.net_learn){
+        std::fill(state.drift_sum.begin(), state.drift_sum.end(), 0.0);
+        std::fill(state.drift_prob.begin(), state.drift_prob.end(), 0.0);
+
+        // A visitor's entries for one host are consecutive
+        for(int i = 0; i < cells.batch.size;){
+            int visitor = cells.visitor[i];
+            int host = cells.batch.host[i];
+            double visit_total = 0;
+            double host_total = 0;
+            for(; i < cells.batch.size && cells.visitor[i] == visitor && cells.batch.host[i] == host; i++){
+                visit_total += cells.batch.visit_payoff[i] * cells.count[i];
+                host_total += cells.batch.host_payoff[i] * cells.count[i];
+            }
+            add_link_drift(population, state, visitor, host, visit_total * params.network_learning_speed);
+            if(params.net_sym){
+                add_link_drift(population, state, host, visitor, host_total * params.network_learning_speed);
+            }
+        }
+
+        // Each link that gained nothing counts its probability times the row's total added
+        for(int agent = 0; agent < pop; agent++){
+            double untouched = std::max(0.0, 1 - state.drift_prob[agent]) * state.net_added[agent];
+            state.drift = std::max(state.drift, (state.drift_sum[agent] + untouched) / state.net_start[agent]);
+        }
+    }
+
+    for(int agent = 0; agent < pop; agent++){
+        for(int role = 0; role < roles; role++){
+            int entry = agent * roles + role;
+            const weight_t *strats = population.curStrats(agent, role);
+            const double *added = &state.strat_added[(size_t) entry * num_strats];
+            double total = std::accumulate(added, added + num_strats, 0.0);
+            double change = 0;
+            for(int s = 0; s < num_strats; s++){
+                double prob = strats[s] * population.cur_strat_scale[entry] / state.strat_start[entry];
+                change += std::fabs(added[s] - prob * total);
+            }
+            state.drift = std::max(state.drift, change / state.strat_start[entry]);
+        }
+    }
+}
+
+// Apply the leap's payoffs: each weight vector gets its discounts of the leap at once and
+// the payoffs reinforced into it, scaled by the mean discount they would have had after
+// them. The discounts per vector are those of the exact updates (update_visitor and
+// update_host): steps visits, and the agent's hostings.
+template<class Rank>
+static void apply_leap(UGenerator &rng, Network &net, const LearningParams &params, int steps, LeapState &state, LeapCells &cells, bool record){
+    Population &population = net.getPopulation();
+    int pop = population.pop;
+    int roles = population.num_roles;
+    int num_strats = population.num_strats;
+    int num_cells = cells.batch.size;
+
+    std::fill(state.hosted.begin(), state.hosted.end(), 0);
+    for(int i = 0; i < num_cells; i++){
+        state.hosted[cells.batch.host[i]] += cells.count[i];
+    }
+
+    state.net_start = state.net_mass;
+    state.strat_start = state.strat_mass;
+    std::fill(state.strat_added.begin(), state.strat_added.end(), 0.0);
+
+    // Discounts of the other role's strategies per interaction (idle role and symmetric strategies)
+    int cross_discounts = (Rank::discount_idle_role ? 1 : 0) + (params.strat_sym ? 1 : 0);
+    for(int agent = 0; agent < pop; agent++){
+        Agent &curAgent = net.GetAgent(agent);
+        int hosted = state.hosted[agent];
+
+        if(params.net_learn){
+            int events = steps + (params.net_sym ? hosted : 0);
+            double factor = std::pow((double) (1-params.network_discount), events);
+            curAgent.scaleNeighbors(factor);
+            state.net_mass[agent] *= factor;
+            state.net_gain[agent] = leap_gain(factor, events, params.network_discount);
+            state.net_added[agent] = 0;
+        }
+        for(int role = 0; role < roles; role++){
+            int events = role == 0 ? steps + hosted * cross_discounts : hosted + steps * cross_discounts;
+            double factor = std::pow((double) (1-params.strategy_discount), events);
+            curAgent.scaleStrategy(role, factor);
+            state.strat_mass[agent * roles + role] *= factor;
+            state.strat_gain[agent * roles + role] = leap_gain(factor, events, params.strategy_discount);
+        }
+    }
+
+    // Dynamic ranks score every strategy payoff, so symmetric strategies score twice
+    double *payoffs = Rank::payoffs(population);
+    double score_share = params.strat_sym ? 2 : 1;
+    for(int i = 0; i < num_cells; i++){
+        int visitor = cells.visitor[i];
+        int host = cells.batch.host[i];
+        int a = cells.batch.visit_strategy[i];
+        int b = cells.batch.host_strategy[i];
+        int count = cells.count[i];
+        double visit_total = cells.batch.visit_payoff[i] * count;
+        double host_total = cells.batch.host_payoff[i] * count;
+        Agent &visitAgent = net.GetAgent(visitor);
+        Agent &hostAgent = net.GetAgent(host);
+
+        if(params.net_learn){
+            double amount = visit_total * params.network_learning_speed;
+            visitAgent.addNetworkWeight(host, amount * state.net_gain[visitor]);
+            state.net_mass[visitor] += amount * state.net_gain[visitor];
+            state.net_added[visitor] += amount;
+            if(params.net_sym){
+                amount = host_total * params.network_learning_speed;
+                hostAgent.addNetworkWeight(visitor, amount * state.net_gain[host]);
+                state.net_mass[host] += amount * state.net_gain[host];
+                state.net_added[host] += amount;
+            }
+        }
+
+        // (agent, role, strategy, payoff total) of each reinforcement
+        int reinforced = params.strat_sym ? 4 : 2;
+        const int agent_of[4] = {visitor, host, visitor, host};
+        const int role_of[4] = {0, 1, 1, 0};
+        const int strategy_of[4] = {a, b, a, b};
+        const double total_of[4] = {visit_total, host_total, visit_total, host_total};
+        for(int r = 0; r < reinforced; r++){
+            int entry = agent_of[r] * roles + role_of[r];
+            double amount = total_of[r] * params.strategy_learning_speed;
+            net.GetAgent(agent_of[r]).addStrategyWeight(role_of[r], strategy_of[r], amount * state.strat_gain[entry]);
+            state.strat_mass[entry] += amount * state.strat_gain[entry];
+            state.strat_added[(size_t) entry * num_strats + strategy_of[r]] += amount;
+        }
+
+        payoffs[visitor] = payoffs[visitor] + visit_total * score_share;
+        payoffs[host] = payoffs[host] + host_total * score_share;
+
+        int interaction_number = a * num_strats + b;
+        population.agentInteractions(visitor)[interaction_number] += count;
+        population.agentInteractions(host)[interaction_number] += count;
+
+        // Each visitor's last interaction for the trackers, one of its leap's visits at random
+        if(record){
+            state.visits_seen[visitor] += count;
+            if(rng() * state.visits_seen[visitor] < count){
+                state.last_cell[visitor] = i;
+            }
+        }
+    }
+
+    leap_drift(population, params, state, cells);
+
+    if(record){
+        for(int agent = 0; agent < pop; agent++){
+            int i = state.last_cell[agent];
+            if(i >= 0){
+                Agent &curAgent = net.GetAgent(agent);
+                curAgent.setCurrentFriend(cells.batch.host[i]);
+                curAgent.recordInteraction(cells.batch.visit_payoff[i], cells.batch.host_payoff[i]);
+            }
+            state.last_cell[agent] = -1;
+            state.visits_seen[agent] = 0;
+        }
+    }
+}
+
+// Longest next leap within the tolerance: at the last leap's rate, no choice probabilities
+// may drift by more than TAU_LEAP in total.  Grows at most twofold per leap.
+static int next_leap(const LeapState &state, int steps, int leap){
+    double limit = std::min(2.0 * leap, (double) TAU_LEAP_MAX_STEPS);
+    if(state.drift > 0){
+        limit = std::min(limit, TAU_LEAP * steps / state.drift);
+    }
+    return std::max(1, (int) limit);
+}
+
+template<class Rank, class Coupling>
+struct LeapKernel{
+    static void run(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net);
+};
+
+template<class Rank, class Coupling>
+void LeapKernel<Rank, Coupling>::run(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net){
+    LearningParams params(net.GetAgent(0));
+
+    tracking_vars.initTrackLocation<Rank>(net, rng, nrng);
+
+    Population &population = net.getPopulation();
+    population.bonus_cache.setTransform(&Coupling::scoreKey, population.cur_score);
+    if(!params.net_learn){
+        population.freezeNetwork();
+    }
+
+    LeapState state;
+    state.init(population);
+    LeapCells cells;
+    cells.batch.num_strats = population.num_strats;
+
+    int leap = 1;
+    for(int t = 1; t < tracking_vars.max_time+1;){
+        int last = leap_end<Rank>(tracking_vars, t, leap);
+        int steps = last - t + 1;
+        bool record = tracking_vars.isRecorded<Rank>(last);
+
+        draw_leap<Coupling>(rng, population, params, steps, state, cells);
+        g.playBatch<Coupling>(cells.batch, 0, cells.batch.size);
+        apply_leap<Rank>(rng, net, params, steps, state, cells, record);
+
+        // Commit, as an exact step ending at last would
+        if(record){
+            tracking_vars.updateData<Rank>(net, rng, nrng, last);
+        }else{
+            for(int agent = 0; agent < population.pop; agent++){
+                net.GetAgent(agent).updateAgent();
+                Rank::commitScore(population, agent);
+            }
+        }
+
+        leap = next_leap(state, steps, leap);
+        t = last + 1;
+    }
+}
+
+void run_tau_leap(UGenerator &rng, NGenerator &nrng, Game &g, SimTracking &tracking_vars, Network &net, RankModel rank_model){
+    dispatch_model<LeapKernel>(rank_model, g, rng, nrng, g, tracking_vars, net);
+}
+#endif
@@ -0,0 +1,53 @@
+#!/bin/bash
+# Allocation check: builds the code with -DALLOC_CHECK (default, batched and -DCOUNTER_RNG
+# timesteps), runs the inputs in SimCode/Regression with each, on one thread per simulation
+# and on several, and fails if any timestep that records no output allocated heap memory.
+# A build with -DALLOC_CHECK_PROBE, which allocates on purpose on every thread but the first
+# that commits a step, must then pass on one thread per simulation and fail on several.
+#
+# Usage (from any folder): SimCode/check_allocations.sh
+
+source "$(dirname "$0")/Regression/harness.sh"
+
+failed=0
+
+# check NAME: the run printed its per-simulation counts and all of them are 0
+check(){
+    local runs=$(grep -c '^Allocation check' "$work/$1.log")
+    local allocating=$(grep '^Allocation check' "$work/$1.log" | grep -v ': 0 allocations' | wc -l)
+    if [ "$runs" -eq 0 ]; then
+        echo "FAILED  $1 ran no simulations"
+        failed=1
+    elif [ "$allocating" -gt 0 ]; then
+        echo "FAILED  $1: $allocating of $runs simulations allocated in untracked timesteps"
+        grep '^Allocation check' "$work/$1.log" | grep -v ': 0 allocations' | head -n 5
+        failed=1
+    else
+        echo "ok      $1: no allocations in the untracked timesteps of $runs simulations"
+    fi
+}
+
+build alloc -DALLOC_CHECK
+build alloc_batched -DALLOC_CHECK -DBATCHED_TIMESTEP
+build alloc_counter -DALLOC_CHECK -DCOUNTER_RNG
+build alloc_probe -DALLOC_CHECK -DALLOC_CHECK_PROBE
+wait_builds
+
+# The binary exits with status 1 on a failed check, which run reports; check says which runs
+for name in alloc alloc_batched alloc_counter; do
+    for run_threads in 1 4; do
+        run ${name}_$run_threads $name Regression 1 $run_threads 4
+        check ${name}_$run_threads
+    done
+done
+
+run alloc_probe_1 alloc_probe Regression 1 1 4
+check alloc_probe_1
+if run_status alloc_probe_4 alloc_probe Regression 1 4 4 || ! grep -q '^Allocation check.*: [1-9][0-9]* allocations' "$work/alloc_probe_4.log"; then
+    echo "FAILED  alloc_probe_4: allocations on the threads sharing a simulation were not caught"
+    failed=1
+else
+    echo "ok      alloc_probe_4: allocations on the threads sharing a simulation were caught"
+fi
+
+exit $failed
@@ -0,0 +1,70 @@
+#!/bin/bash
+# Regression check: runs the inputs in SimCode/Regression (every rank model and coupling,
+# symmetric learning, a substrate graph, a population sampled with the sum tree and a game of three
+# strategies) and fails if
+#  - the default build's outputs differ from the stored baseline (Regression/Baseline.sha256);
+#  - any build's outputs change with THREADS or with the threads per simulation;
+#  - the -DBATCHED_TIMESTEP build's outputs differ from the default build's, or the
+#    -DCOUNTER_RNG ones differ serial, batched and in lockstep ensembles (-DENSEMBLE).
+#
+# Usage (from any folder): SimCode/check_regression.sh [--update]
+# --update rewrites the baseline from the default build, for changes that are meant to
+# alter results (say so in the commit).
+
+source "$(dirname "$0")/Regression/harness.sh"
+
+output=HDInnov_Output_Data/Output_Regression
+seeds=4
+failed=0
+
+# same NAME1 NAME2: the two runs wrote identical output files
+same(){
+    if diff -r -q "$work/$1/$output" "$work/$2/$output" > "$work/diff.log"; then
+        echo "ok      $1 = $2"
+    else
+        echo "FAILED  $1 != $2"
+        head -n 5 "$work/diff.log"
+        failed=1
+    fi
+}
+
+build default
+build batched -DBATCHED_TIMESTEP
+build counter -DCOUNTER_RNG
+build counter_batched -DCOUNTER_RNG -DBATCHED_TIMESTEP
+build ensemble -DCOUNTER_RNG -DENSEMBLE=4
+wait_builds
+
+run default default Regression 1 1 $seeds
+run default_threads default Regression 4 1 $seeds
+run default_run_threads default Regression 1 4 $seeds
+run batched batched Regression 1 1 $seeds
+run batched_run_threads batched Regression 4 4 $seeds
+run counter counter Regression 1 1 $seeds
+run counter_threads counter Regression 4 1 $seeds
+run counter_run_threads counter Regression 1 4 $seeds
+run counter_batched counter_batched Regression 1 4 $seeds
+run ensemble ensemble Regression 4 1 $seeds
+
+(cd "$work/default/$output" && sha256sum * | sort -k 2) > "$work/default.sha256"
+if [ "$1" == "--update" ]; then
+    cp "$work/default.sha256" "$regression_dir/Baseline.sha256"
+    echo "Baseline updated"
+elif diff "$regression_dir/Baseline.sha256" "$work/default.sha256" > "$work/diff.log"; then
+    echo "ok      default = baseline"
+else
+    echo "FAILED  default != baseline, changed files:"
+    grep '^>' "$work/diff.log" | awk '{print "        " $3}' | head -n 20
+    failed=1
+fi
+
+same default default_threads
+same default default_run_threads
+same default batched
+same default batched_run_threads
+same counter counter_threads
+same counter counter_run_threads
+same counter counter_batched
+same counter ensemble
+
+exit $failed
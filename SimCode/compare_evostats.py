@@ -0,0 +1,89 @@
+"""Compare the EvoStats output of two builds of the simulation code (for example the
+    default double build against one compiled with -DFLOAT_WEIGHTS), run on the same
+    inputs and seeds.
+
+    Single runs diverge once any draw goes the other way, so the comparison is over
+    seeds: for each key, the seed-mean interaction proportions of the two builds are
+    compared at every tracked timestep, next to the standard error of the difference of
+    the two means (from each build's sample variance over the seeds, as if the builds' runs
+    were independent).
+
+    Columns: the largest difference of the means over tracked times and interaction types
+    (MaxMeanDiff), the largest standard error of that difference (MaxDiffStdErr), the
+    largest difference at the last tracked time (FinalDiff), and the first tracked time at
+    which any single run differs by more than output rounding (FirstSplitT, nan if none).
+
+    Usage: python compare_evostats.py REFERENCE_OUTPUT_FOLDER TEST_OUTPUT_FOLDER
+    (e.g. HDInnov_Output_Data/Output_X from each build)
+
+    SimCode/compare_float_weights.sh builds the default and -DFLOAT_WEIGHTS binaries, runs keys
+    K1-K7 of SimCode/Regression/HDInnov_Input/Input_HDInnov_FloatWeights with both over the 20
+    seeds of SimCode/Regression/Seeds.csv and runs this script on the outputs. All keys have
+    network and strategy discount and tremble 0.01 and pop 20 over 20000 timesteps, except K3
+    (pop 150 over 5000). K1, K3, K4 and K5 are static, K2 and K7 dynamic. All use the Fight
+    coupling but K4 (FightRand) and K6 (FightSplit). K5 has no network learning, and K6 and
+    K7 learn symmetrically (SymN and SymS 1). Its output:
+
+    Key           Seeds  MaxMeanDiff  MaxDiffStdErr    FinalDiff  FirstSplitT
+    K1               20       0.0000         0.0356       0.0000          nan
+    K2               20       0.0000         0.0613       0.0000          nan
+    K3               20       0.0000         0.0122       0.0000          nan
+    K4               20       0.0000         0.0433       0.0000          nan
+    K5               20       0.0000         0.0828       0.0000          nan
+    K6               20       0.0002         0.0192       0.0000         9000
+    K7               20       0.0000         0.0563       0.0000          nan
+
+    In 139 of the 140 runs the float and double EvoStats agree up to output rounding (in 4 of
+    them, of K3, K6 and K7, the last printed digit differs at a few tracked times). The one
+    exception is a run of K6, a static key: seed 5948 splits between t = 8000 and 9000. A run
+    splits when a single partner or strategy draw lands within float rounding of the boundary
+    between two choices and goes the other way, after which the two runs follow different
+    trajectories. Such draws are rare, so whether a run splits is down to chance rather than
+    its rank model, and any key can split; the more weight updates a run makes, the likelier it
+    is, and K6's symmetric learning updates both agents' weights in every interaction. The split
+    run stays in the same convention, so K6's seed mean moves by at most 0.0002, well inside the
+    standard error of the difference (0.0192).
+
+    """
+
+import os, sys
+import re
+from collections import defaultdict
+import numpy as np
+
+# EvoStats files by key, then seed
+def load_evostats(folder):
+    runs = defaultdict(dict)
+    for name in os.listdir(folder):
+        match = re.match(r'.*_EvoStats_(.+)_(\d+)_\d+\.csv$', name)
+        if match:
+            runs[match.group(1)][match.group(2)] = np.loadtxt(os.path.join(folder,name), delimiter=',')
+    return runs
+
+def compare(ref_folder, test_folder):
+    ref_runs = load_evostats(ref_folder)
+    test_runs = load_evostats(test_folder)
+
+    print('%-12s %6s %12s %14s %12s %12s' % ('Key','Seeds','MaxMeanDiff','MaxDiffStdErr','FinalDiff','FirstSplitT'))
+    for key in sorted(set(ref_runs) & set(test_runs)):
+        seeds = sorted(set(ref_runs[key]) & set(test_runs[key]))
+        if len(seeds) == 0:
+            continue
+        ref = np.array([ref_runs[key][s] for s in seeds]) # seeds x times x (index + 4 columns)
+        test = np.array([test_runs[key][s] for s in seeds])
+        times = ref[0,:,0]
+
+        mean_diff = np.abs(ref[:,:,1:].mean(axis=0) - test[:,:,1:].mean(axis=0))
+        std_err = np.sqrt((ref[:,:,1:].var(axis=0, ddof=1) + test[:,:,1:].var(axis=0, ddof=1)) / len(seeds)) if len(seeds) > 1 else np.full(mean_diff.shape, np.nan)
+
+        # First tracked time any single run differs beyond output rounding
+        split = np.abs(ref[:,:,1:] - test[:,:,1:]).max(axis=(0,2)) > 0.0015
+        first_split = times[np.argmax(split)] if split.any() else float('nan')
+
+        print('%-12s %6d %12.4f %14.4f %12.4f %12g' % (key, len(seeds), mean_diff.max(), std_err.max(), mean_diff[-1].max(), first_split))
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+    compare(sys.argv[1], sys.argv[2])
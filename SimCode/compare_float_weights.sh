@@ -0,0 +1,20 @@
+#!/bin/bash
+# Single against double precision weights: builds the default and -DFLOAT_WEIGHTS binaries,
+# runs keys K1-K7 of SimCode/Regression/HDInnov_Input/Input_HDInnov_FloatWeights over 20 seeds
+# with each, and prints compare_evostats.py's comparison (its header records the output).
+#
+# Usage (from any folder): SimCode/compare_float_weights.sh [THREADS]
+
+source "$(dirname "$0")/Regression/harness.sh"
+
+threads=${1:-4}
+output=HDInnov_Output_Data/Output_FloatWeights
+
+build double
+build float -DFLOAT_WEIGHTS
+wait_builds
+
+run double double FloatWeights $threads 1 20
+run float float FloatWeights $threads 1 20
+
+python "$sim_dir/compare_evostats.py" "$work/double/$output" "$work/float/$output"